@@ -87,6 +87,64 @@
     Program ast_root;       /* the result of the parse  */
     Classes parse_results;        /* for use in semantic analysis */
     int omerrs = 0;               /* number of errors in lexing and parsing */
+
+    #ifdef COOL_PURE_PARSER
+    /* Built as a pure parser (make parser-pure), whose state is in its
+     * parse_context rather than in the globals above; see parse-context.h */
+    #include "parse-context.h"
+    #define curr_filename (parser->filename)
+    #define node_lineno   (parser->node_lineno)
+    #define ast_root      (parser->ast_root)
+    #define parse_results (parser->parse_results)
+    #endif
+
+    #ifdef COOL_CHECK_PARSER
+    /* Built to check syntax only (make parser-check): the constructors the
+     * actions call become NULL, without evaluating their arguments, so no
+     * node is made and no string added to a table.  The actions are left
+     * with copying NULLs, and the parse with the parser's stacks. */
+    #define program(...)         NULL
+    #define class_(...)          NULL
+    #define method(...)          NULL
+    #define attr(...)            NULL
+    #define formal(...)          NULL
+    #define branch(...)          NULL
+    #define assign(...)          NULL
+    #define static_dispatch(...) NULL
+    #define dispatch(...)        NULL
+    #define cond(...)            NULL
+    #define loop(...)            NULL
+    #define typcase(...)         NULL
+    #define block(...)           NULL
+    #define let(...)             NULL
+    #define plus(...)            NULL
+    #define sub(...)             NULL
+    #define mul(...)             NULL
+    #define divide(...)          NULL
+    #define neg(...)             NULL
+    #define lt(...)              NULL
+    #define eq(...)              NULL
+    #define leq(...)             NULL
+    #define comp(...)            NULL
+    #define int_const(...)       NULL
+    #define bool_const(...)      NULL
+    #define string_const(...)    NULL
+    #define new_(...)            NULL
+    #define isvoid(...)          NULL
+    #define no_expr()            NULL
+    #define object(...)          NULL
+    #define nil_Classes()        NULL
+    #define single_Classes(...)  NULL
+    #define nil_Features()       NULL
+    #define single_Features(...) NULL
+    #define nil_Formals()        NULL
+    #define single_Formals(...)  NULL
+    #define nil_Expressions()    NULL
+    #define single_Expressions(...) NULL
+    #define nil_Cases()          NULL
+    #define single_Cases(...)    NULL
+    #define extend(...)          NULL
+    #endif
     %}
     
     /* A union of all the types that can be the result of parsing actions. */
@@ -180,7 +238,9 @@
                     /* per variable declaration, "used in semantic analysis" */
                     parse_results = $$; }
                 | class_list class {
-                    $$ = append_Classes($1,single_Classes($2));
+                    /* lists are grown in place, not by append_Classes, so
+                     * that they are arrays rather than chains; see tree.h */
+                    $$ = extend($1, $2);
                     parse_results = $$; }
                 ;
     
@@ -205,7 +265,7 @@
                     | { $$ = nil_Features(); }
                     ;
     features    : feature ';' { $$ = single_Features($1); }
-                | features feature ';' { $$ = append_Features($1, single_Features($2)); }
+                | features feature ';' { $$ = extend($1, $2); }
                 | error ';' { yyclearin; $$ = NULL; }
                 ;
     feature     : OBJECTID '(' formals ')' ':' TYPEID '{' expr '}' { $$ = method($1, $3, $6, $8); }
@@ -216,7 +276,7 @@
 
     /* formals are comma-separated arguments, i.e. "formal parameters" */
     formals     : formal { $$ = single_Formals($1); }
-                | formals ',' formal { $$ = append_Formals($1, single_Formals($3)); }
+                | formals ',' formal { $$ = extend($1, $3); }
                 /* empty argument list allowed */
                 | { $$ = nil_Formals(); }
                 ;
@@ -285,21 +345,21 @@
      * this is not the same as comma-separated expressions (e.g. a list of arguments)
      */
     one_or_more_expr    : expr ';' { $$ = single_Expressions($1); }
-                        | one_or_more_expr expr ';' { $$ = append_Expressions($1, single_Expressions($2)); }
+                        | one_or_more_expr expr ';' { $$ = extend($1, $2); }
                         /* recover from an expression inside a block */
                         | error ';' { yyclearin; $$ = NULL; }
                         ;
 
     param_expr          : expr { $$ = single_Expressions($1); }
-                        | param_expr ',' expr { $$ = append_Expressions($1, single_Expressions($3)); }
+                        | param_expr ',' expr { $$ = extend($1, $3); }
                         /* include nil because params are optional */
                         | { $$ = nil_Expressions(); }
                         ;
 
     /* must have at least one case_branch */
     case_branch_list    : case_branch { $$ = single_Cases($1); }
-                        /* "The function `append_Phylums` appends two lists of phylums */
-                        | case_branch_list case_branch { $$ = append_Cases($1, single_Cases($2)); }
+                        /* extend adds the branch to the list in place; see tree.h */
+                        | case_branch_list case_branch { $$ = extend($1, $2); }
                         ;
     case_branch         : OBJECTID ':' TYPEID DARROW expr ';' { $$ = branch($1, $3, $5); }
                         ;
@@ -307,7 +367,9 @@
     /* end of grammar */
     %%
     
-    /* This function is called automatically when Bison detects a parse error. */
+    /* This function is called automatically when Bison detects a parse error.
+     * The pure parser's is cool_yyerror in parser-pure.cc. */
+    #ifndef COOL_PURE_PARSER
     void yyerror(char *s)
     {
       extern int curr_lineno;
@@ -320,5 +382,6 @@
       
       if(omerrs>50) {fprintf(stdout, "More than 50 errors\n"); exit(1);}
     }
+    #endif
     
     
\ No newline at end of file
@@ -0,0 +1 @@
+/usr/class/cs143/cool/src/PA3/cool-tree.cc
\ No newline at end of file
@@ -0,0 +1,8 @@
+class A {
+ana(): Int {
+(let x:Int <- 1 in 2)+3
+};
+};
+
+Class BB__ inherits A {
+};
@@ -0,0 +1 @@
+/usr/class/cs143/cool/src/PA3/parser-phase.cc
\ No newline at end of file
@@ -0,0 +1 @@
+/usr/class/cs143/cool/src/PA3/tokenstream.cc
\ No newline at end of file
@@ -0,0 +1,17 @@
+class C {
+	a : Int;
+	b : Bool;
+	init(x : Int, y : Bool) : C {
+           {
+		a <- x;
+		b <- y;
+		self;
+           }
+	};
+};
+
+Class Main {
+	main():C {
+	  (new C).init(1,true)
+	};
+};
@@ -0,0 +1 @@
+/usr/class/cs143/cool/src/PA4/handle_flags.cc
\ No newline at end of file
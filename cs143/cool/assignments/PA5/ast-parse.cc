@@ -0,0 +1 @@
+/usr/class/cs143/cool/src/PA5/ast-parse.cc
\ No newline at end of file
@@ -0,0 +1 @@
+/usr/class/cs143/cool/src/PA5/cgen-phase.cc
\ No newline at end of file
@@ -0,0 +1,9 @@
+
+(*  Example cool program testing as many aspects of the code generator
+    as possible.
+ *)
+
+class Main {
+  main():Int { 0 };
+};
+
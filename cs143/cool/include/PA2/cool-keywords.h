@@ -0,0 +1,139 @@
+// -*-Mode: C++;-*-
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _COOL_KEYWORDS_H_
+#define _COOL_KEYWORDS_H_
+
+//////////////////////////////////////////////////////////////////////
+//
+//  cool-keywords.h
+//
+//  Keyword recognition by perfect hashing.
+//
+//  The direct-coded scanner (cool-direct.cc) has no keyword rules:
+//  it scans keywords as identifiers and looks each one up with
+//  cool_keyword.
+//
+//  The hash of a word is computed from its length and its first and
+//  last letters, ignoring case; no two keywords agree in all three.
+//  The multipliers that make the hash collision-free, and the table it
+//  indexes, are computed by the compiler.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "cool-parse.h"
+
+namespace cool_keywords {
+
+struct Keyword {
+  const char *name;      // in lower case
+  int len;
+  int token;
+};
+
+constexpr Keyword keywords[] = {
+  { "class", 5, CLASS },       { "else", 4, ELSE },
+  { "fi", 2, FI },             { "if", 2, IF },
+  { "in", 2, IN },             { "inherits", 8, INHERITS },
+  { "let", 3, LET },           { "loop", 4, LOOP },
+  { "pool", 4, POOL },         { "then", 4, THEN },
+  { "while", 5, WHILE },       { "case", 4, CASE },
+  { "esac", 4, ESAC },         { "of", 2, OF },
+  { "new", 3, NEW },           { "isvoid", 6, ISVOID },
+  { "not", 3, NOT },           { "true", 4, BOOL_CONST },
+  { "false", 5, BOOL_CONST },
+};
+
+constexpr int NKEYWORDS = sizeof(keywords) / sizeof(keywords[0]);
+constexpr int MIN_LEN = 2;
+constexpr int MAX_LEN = 8;
+constexpr int TABLE_SIZE = 64;    // a power of two
+
+// Lower-case a character of an identifier.  Digits are unchanged, and
+// '_' becomes DEL, which is in no keyword.
+constexpr unsigned lower(char c) { return (unsigned char) c | 0x20; }
+
+constexpr unsigned hash(unsigned a, unsigned b, const char *s, int len)
+{
+  return (lower(s[0]) * a + lower(s[len - 1]) * b + len) & (TABLE_SIZE - 1);
+}
+
+// Does the pair of multipliers a, b give every keyword its own slot?
+constexpr bool perfect(unsigned a, unsigned b)
+{
+  bool used[TABLE_SIZE] = { };
+  for (int i = 0; i < NKEYWORDS; i++) {
+    unsigned h = hash(a, b, keywords[i].name, keywords[i].len);
+    if (used[h])
+      return false;
+    used[h] = true;
+  }
+  return true;
+}
+
+// The first perfect pair, as a * 256 + b, or 0 if there is none.
+constexpr unsigned find_multipliers()
+{
+  for (unsigned a = 1; a < 256; a++)
+    for (unsigned b = 1; b < 256; b++)
+      if (perfect(a, b))
+        return a * 256 + b;
+  return 0;
+}
+
+constexpr unsigned multipliers = find_multipliers();
+static_assert(multipliers != 0, "no perfect hash for the keywords");
+constexpr unsigned A = multipliers / 256;
+constexpr unsigned B = multipliers % 256;
+
+// Slot h of the table holds 1 + the index of the keyword that hashes to
+// h, or 0.
+struct Table {
+  unsigned char slot[TABLE_SIZE];
+};
+
+constexpr Table make_table()
+{
+  Table t = { };
+  for (int i = 0; i < NKEYWORDS; i++)
+    t.slot[hash(A, B, keywords[i].name, keywords[i].len)] = i + 1;
+  return t;
+}
+
+constexpr Table table = make_table();
+
+} // namespace cool_keywords
+
+//
+// If the identifier of len characters at s is a keyword, return its token
+// and, for true and false, set lval->boolean.  Otherwise return 0.  As in
+// the keyword rules, case is ignored, except that true and false must
+// begin with a lower-case letter.
+//
+inline int cool_keyword(const char *s, int len, YYSTYPE *lval)
+{
+  using namespace cool_keywords;
+  if (len < MIN_LEN || len > MAX_LEN)
+    return 0;
+  int k = table.slot[hash(A, B, s, len)];
+  if (k == 0)
+    return 0;
+  const Keyword &kw = keywords[k - 1];
+  if (kw.len != len)
+    return 0;
+  for (int i = 0; i < len; i++)
+    if (lower(s[i]) != (unsigned char) kw.name[i])
+      return 0;
+  if (kw.token == BOOL_CONST) {
+    if (s[0] != kw.name[0])
+      return 0;
+    lval->boolean = s[0] == 't';
+  }
+  return kw.token;
+}
+
+#endif
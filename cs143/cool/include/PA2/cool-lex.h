@@ -0,0 +1,154 @@
+// -*-Mode: C++;-*-
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _COOL_LEX_H_
+#define _COOL_LEX_H_
+
+//////////////////////////////////////////////////////////////////////
+//
+//  cool-lex.h
+//
+//  The interface to reentrant Cool scanners.
+//
+//  The scanner generated from cool.flex keeps no global state, so any
+//  number of scanners can run at once, one per thread.  Each scanner is
+//  described by a cool_lex_state, created with cool_lex_new.  cool_lex
+//  returns the next token of a scanner; the token's semantic value and
+//  line number are left in the state's lval and lineno fields.
+//
+//  cool_lex_tokens lexes many tokens at once into a TokenBuffer (see
+//  tokenstream.h), saving the call and the copies made for each token
+//  by cool_lex.
+//
+//  The classic interface (cool_yylex, cool_yylval, curr_lineno and fin)
+//  is implemented on top of a default scanner.
+//
+//  A cool_relex keeps the tokens of a text up to date as the text is
+//  edited, re-scanning only the lines around each edit.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include "cool-parse.h"
+#include "tokenstream.h"
+
+/* Max size of string constants */
+#define MAX_STR_CONST 1025
+
+struct yy_buffer_state;
+
+//
+// The state of a scanner at the start of a line.  Scanning can start
+// again at any line start whose string_length is 0 (strings cannot be
+// resumed, as the text assembled so far is not kept), and will give the
+// same tokens from there on as long as the text that follows is the same.
+//
+struct cool_lex_checkpoint {
+  int offset;            // of the line start in the text
+  int token;             // the number of tokens before it
+  int start;             // the start condition (INITIAL, COMMENT, ...)
+  int comment_depth;
+  int string_length;     // of a string constant begun on an earlier line
+};
+
+struct cool_checkpoints {
+  cool_lex_checkpoint *cps;   // one for each line, in order
+  int count;
+  int size;              // allocated length of cps
+};
+
+struct cool_lex_state {
+  void *scanner;                   // the flex scanner (a yyscan_t)
+  FILE *fin;                       // we read from this file
+  int lineno;                      // the current line number
+  YYSTYPE lval;                    // semantic value of the last token
+
+  int comment_depth;               // nesting depth of (* *) comments
+  char string_buf[MAX_STR_CONST];  // to assemble string constants
+  int string_length;               // number of chars in string_buf
+
+  // The file being scanned in memory, if any (see cool_lex_map_file),
+  // and the buffer that reads from fin, to go back to afterwards.
+  struct yy_buffer_state *file_buffer;
+  struct yy_buffer_state *fin_buffer;
+  char *file_base;                 // the text of the file, then two NULs
+  size_t file_len;                 // length of file_base, with the NULs
+  bool file_mapped;                // file_base is mapped, not malloc'ed
+
+  // Text being scanned in place (see cool_lex_set_text).  While
+  // checkpoints is set, a checkpoint is added to it for every line start
+  // the scanner passes; ntokens is the number of tokens before the text
+  // being matched, and is kept up to date by the caller.
+  struct yy_buffer_state *text_buffer;
+  const char *text_base;
+  cool_checkpoints *checkpoints;
+  int ntokens;
+};
+
+// Create a scanner reading from f, starting at line 1.
+cool_lex_state *cool_lex_new(FILE *f);
+void cool_lex_delete(cool_lex_state *ls);
+
+// Return the next token, or 0 at the end of the input.
+int cool_lex(cool_lex_state *ls);
+
+// Add the next max tokens, or as many as are left, to buf.  Returns the
+// number of tokens added, which is less than max only at the end of the
+// input.
+int cool_lex_tokens(cool_lex_state *ls, TokenBuffer &buf, int max);
+
+// Scan the regular file f in memory; see cool.flex.  Returns false, and
+// leaves the scanner reading from its fin, if f is not a regular file.
+bool cool_lex_map_file(cool_lex_state *ls, FILE *f);
+void cool_lex_unmap_file(cool_lex_state *ls);
+
+// Scan the size bytes at base, the last two of which must be NULs, in
+// place.  Scanning begins in start condition start, with the given
+// comment depth.  cool_lex_end_text undoes the changes the scanner made
+// to the text, and may be called before the end is reached.
+void cool_lex_set_text(cool_lex_state *ls, char *base, int size,
+                       int start, int comment_depth);
+void cool_lex_end_text(cool_lex_state *ls);
+
+// Called by the scanner before each action to record checkpoints.
+void cool_lex_note_lines(cool_lex_state *ls, int start,
+                         const char *text, int len);
+
+// The same, for the default scanner used by cool_yylex.
+int cool_yylex();
+int cool_yylex_tokens(TokenBuffer &buf, int max);
+bool cool_yy_map_file(FILE *f);
+void cool_yy_unmap_file();
+
+//
+// Incremental lexing.  tokens holds the tokens of text, and lines a
+// checkpoint for the start of each line of it.
+//
+struct cool_relex {
+  cool_lex_state *ls;
+  char *text;            // the text, followed by two NULs
+  int len;               // the length of the text
+  int size;              // allocated length of text
+  TokenBuffer tokens;
+  cool_checkpoints lines;
+};
+
+cool_relex *cool_relex_new();
+void cool_relex_delete(cool_relex *r);
+
+// Replace the old_len bytes at offset by the len bytes at text, and bring
+// tokens and lines up to date.  Scanning starts at the last line start
+// before the edit that can be resumed, and stops at the first line start
+// after it where the state of the scanner is the same as it was at the
+// same place in the old text.  Returns the number of lines scanned.
+int cool_relex_edit(cool_relex *r, int offset, int old_len,
+                    const char *text, int len);
+
+// Replace the whole text.
+int cool_relex_set_text(cool_relex *r, const char *text, int len);
+
+#endif
@@ -0,0 +1,69 @@
+// -*-Mode: C++;-*-
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _TOKENCACHE_H_
+#define _TOKENCACHE_H_
+
+//////////////////////////////////////////////////////////////////////
+//
+//  tokencache.h
+//
+//  An on-disk cache of the tokens of source files (lexer option -C).
+//
+//  The tokens of a file are stored under a key that is a hash of the
+//  file's text and of a version stamp, so a file whose text has been
+//  seen before need not be scanned again, whatever its name.  The stamp
+//  is a hash of the lexer executable itself: a lexer that has been
+//  rebuilt, or built with another scanner, never sees the entries of
+//  another.
+//
+//  Each entry is a file in the cache directory, named by the key in
+//  hexadecimal.  It holds TOKEN_CACHE_MAGIC and the stamp, then a record
+//  in the layout of a binary token stream (see tokenstream.h): the
+//  strings the tokens use, from each table, followed by the tokens,
+//  whose symbols are indices into those strings.  An entry that cannot
+//  be read, or does not match, is a miss.  Entries are written to a
+//  temporary file and renamed into place, so several lexers may share a
+//  cache.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include "cool-io.h"
+#include "tokenstream.h"
+
+#define TOKEN_CACHE_MAGIC "\0COOLTKC"
+#define TOKEN_CACHE_MAGIC_LEN 8
+
+typedef unsigned long long cache_key;
+
+class TokenCache {
+private:
+  char *dir;                       // the cache directory
+  cache_key stamp;                 // version stamp, part of every key
+  int hits, misses;                // files found, and not found
+
+  char *entry_name(cache_key key, const char *suffix);
+public:
+  // Use the cache in directory dir, which is created if need be.
+  TokenCache(char *dir);
+
+  // Look up the tokens of the file f, from its start.  On a hit the
+  // tokens are added to tokens and true is returned.  Otherwise *key is
+  // set for store, and f is left at its start to be scanned.  Files
+  // other than regular files are not cached; their key is 0.
+  bool lookup(FILE *f, TokenBuffer &tokens, cache_key *key);
+
+  // Store the tokens of the file with the given key.
+  void store(cache_key key, TokenBuffer &tokens);
+
+  // Print the number of hits and misses.  lookup and store may be
+  // called from several threads at once.
+  void print_stats(ostream &out);
+};
+
+#endif
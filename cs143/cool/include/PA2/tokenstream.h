@@ -0,0 +1,123 @@
+// -*-Mode: C++;-*-
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _TOKENSTREAM_H_
+#define _TOKENSTREAM_H_
+
+//////////////////////////////////////////////////////////////////////
+//
+//  tokenstream.h
+//
+//  Token buffers, and binary token streams.
+//
+//  A TokenBuffer holds a sequence of tokens in parallel arrays of kinds,
+//  line numbers and values, so that the tokens of a file, or of a large
+//  part of one, can be lexed and passed on at once (see cool_lex_tokens
+//  in cool-lex.h).
+//
+//  Binary token streams are an alternative to the text format of
+//  dump_cool_token for passing tokens from the lexer to the parser
+//  (option -b of both).
+//
+//  A binary stream starts with TOKEN_STREAM_MAGIC, followed by one
+//  record per input file:
+//
+//      the name of the file
+//      the strings of idtable, inttable and stringtable that the tokens
+//        of the record are the first to use, each table in the order
+//        of first use
+//      the number of tokens, then the tokens
+//
+//  A token is its kind and line number, followed for symbols by the
+//  index of its string among those sent for its table so far, for
+//  booleans by 0 or 1, and for errors by the message.  Each string is
+//  sent once, in the first record that uses it, so the reader interns
+//  every string once rather than once per token, and the stream depends
+//  only on the tokens.
+//
+//  All numbers, including the lengths that precede strings, are
+//  unsigned and written seven bits to a byte, least significant first,
+//  with the high bit set in every byte but the last.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "cool-io.h"
+#include "cool-parse.h"
+
+//
+// The error message of an ERROR token is copied when it is added, so it
+// stays valid after the scanner has moved on.
+//
+class TokenBuffer {
+private:
+  void grow();                     // double size
+
+  TokenBuffer(const TokenBuffer &);              // not copyable
+  TokenBuffer &operator=(const TokenBuffer &);
+public:
+  int count;                       // the number of tokens
+  int size;                        // the allocated length of the arrays
+  short *kinds;                    // the token kinds
+  int *lines;                      // the line number of each token
+  YYSTYPE *values;                 // symbol, boolean or error message,
+                                   // which the buffer has its own copy of
+
+  TokenBuffer() : count(0), size(0), kinds(NULL), lines(NULL),
+                  values(NULL) { }
+  ~TokenBuffer();
+
+  void add(int kind, int line, YYSTYPE &value)
+  {
+    if (count == size)
+      grow();
+    kinds[count] = kind;
+    lines[count] = line;
+    values[count] = value;
+    if (kind == ERROR)
+      values[count].error_msg = strdup(value.error_msg);
+    count++;
+  }
+
+  // Make room for n tokens in all.
+  void reserve(int n);
+
+  // Free the error messages copied by add for tokens [begin, end).
+  void free_messages(int begin, int end);
+
+  // Empty the buffer, keeping its arrays for the next tokens.
+  void clear()                     { free_messages(0, count); count = 0; }
+
+  // Empty the buffer without freeing its error messages, once they
+  // have been handed over to another buffer.
+  void release()                   { count = 0; }
+};
+
+// Print the tokens of buf with dump_cool_token.
+void dump_cool_tokens(ostream &out, TokenBuffer &buf);
+
+#define TOKEN_STREAM_MAGIC "\0COOLTOK"   // can't begin a text stream
+#define TOKEN_STREAM_MAGIC_LEN 8
+
+// Writing.  write_binary_file writes the record of a file with the
+// given tokens to out.
+void write_binary_file(ostream &out, char *name, TokenBuffer &tokens);
+
+// Reading.  read_binary_file adds the tokens of the next file record in
+// to tokens, and sets *name to the name of the file.  It returns false at
+// the end of the stream.
+bool read_binary_file(FILE *in, TokenBuffer &tokens, char **name);
+
+// cool_binary_yylex returns the next token from in, setting cool_yylval,
+// curr_lineno and, at the start of each file, curr_filename.  It returns
+// 0 at the end of the stream.  The stream is decoded a file record at a
+// time with read_binary_file, and the tokens returned from the record.
+int cool_binary_yylex(FILE *in);
+
+#endif
@@ -0,0 +1,96 @@
+// -*-Mode: C++;-*-
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+
+//////////////////////////////////////////////////////////////////////
+//
+//  arena.h
+//
+//  This file implements a bump-pointer allocator.  An Arena hands out
+//  memory from large chunks, in the order it is requested, so objects
+//  allocated one after another are adjacent in memory.  Objects are
+//  never freed one at a time; release() frees every chunk at once.
+//
+//  Objects are placed in an arena with
+//
+//      T *t = new (arena) T(...);
+//
+//  No destructor is run for such objects, so only objects whose
+//  destructors do nothing useful should be allocated this way.
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+#include <stdlib.h>
+#include "cool-io.h"
+
+class Arena {
+private:
+  struct Chunk {
+    Chunk *next;        // the previously allocated chunk
+  };
+
+  enum { ALIGN = 8 };   // alignment of every allocation
+  enum { CHUNK_SIZE = 64 * 1024 };
+
+  Chunk *chunks;        // list of chunks, most recent first
+  char *free_ptr;       // next free byte of the current chunk
+  char *limit;          // end of the current chunk
+
+  // Start a new chunk large enough for size bytes and allocate from it.
+  void *alloc_chunk(size_t size)
+  {
+    size_t csize = sizeof(Chunk) + size;
+    if (csize < CHUNK_SIZE)
+      csize = CHUNK_SIZE;
+    Chunk *c = (Chunk *) malloc(csize);
+    if (c == NULL) {
+      cerr << "out of memory\n";
+      exit(1);
+    }
+    c->next = chunks;
+    chunks = c;
+    free_ptr = (char *) c + sizeof(Chunk) + size;
+    limit = (char *) c + csize;
+    return (char *) c + sizeof(Chunk);
+  }
+
+  Arena(const Arena &);            // not copyable
+  Arena &operator=(const Arena &);
+public:
+  Arena() : chunks(NULL), free_ptr(NULL), limit(NULL) { }
+  ~Arena() { release(); }
+
+  // Allocate size bytes aligned for any object.
+  void *alloc(size_t size)
+  {
+    size = (size + ALIGN - 1) & ~((size_t) ALIGN - 1);
+    if (size > (size_t) (limit - free_ptr))
+      return alloc_chunk(size);
+    void *p = free_ptr;
+    free_ptr += size;
+    return p;
+  }
+
+  // Free all memory allocated from the arena.
+  void release()
+  {
+    while (chunks) {
+      Chunk *c = chunks;
+      chunks = c->next;
+      free(c);
+    }
+    free_ptr = limit = NULL;
+  }
+};
+
+inline void *operator new(size_t size, Arena &a) { return a.alloc(size); }
+inline void operator delete(void *, Arena &) { }
+
+#endif
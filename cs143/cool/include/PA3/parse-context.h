@@ -0,0 +1,71 @@
+// -*-Mode: C++;-*-
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _PARSE_CONTEXT_H_
+#define _PARSE_CONTEXT_H_
+
+//////////////////////////////////////////////////////////////////////
+//
+//  parse-context.h
+//
+//  The state of one run of the pure parser.
+//
+//  "make parser-pure" builds cool.y as a pure bison parser,
+//
+//      int cool_yyparse(parse_context *parser);
+//
+//  whose lookahead token, semantic values and locations are local to the
+//  call.  What cool.y's actions keep in globals (curr_filename,
+//  node_lineno, ast_root and parse_results) is kept in the parser's
+//  parse_context instead; cool.y defines those names as its fields when
+//  COOL_PURE_PARSER is defined.  Several files can then be parsed at once,
+//  each on a thread of its own with a context of its own.  Such a thread
+//  points node_line (see tree.h) at its context's node_lineno, so that
+//  nodes take their line numbers from it, and makes its nodes in its
+//  context's arena.
+//
+//  The parser reads its tokens from a TokenBuffer, or from a range of one:
+//  with -S each file is also cut into ranges of whole classes, which are
+//  parsed apart.  Its error messages are kept, not printed, so that those
+//  of several parsers can be printed in the order of their files.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+#include "arena.h"
+#include "cool-tree.h"
+
+class TokenBuffer;
+union YYSTYPE;
+
+struct parse_context {
+  TokenBuffer *tokens;             // the tokens to parse
+  int next;                        // the index of the next token
+  int end;                         // the index after the last one
+  int last;                        // the index of the last token read,
+                                   // or -1 at the end of the tokens
+  char *filename;                  // the file the tokens are from
+  int node_lineno;                 // the line number of new nodes
+  int omerrs;                      // the number of errors
+  bool stopped;                    // too many errors; parse no further
+  Program ast_root;                // the result of the parse
+  Classes parse_results;
+  std::vector<std::string> messages;  // the error messages
+  Arena arena;                     // the nodes of the parse
+
+  // Parse the tokens of t from begin up to end, or up to the last if end
+  // is -1.
+  parse_context(TokenBuffer *t, char *name, int begin = 0, int end = -1);
+};
+
+// The scanner and error routine of the pure parser.  The location of a
+// token is its line number.
+int cool_yylex(union YYSTYPE *lval, int *lloc, parse_context *parser);
+void cool_yyerror(int *lloc, parse_context *parser, const char *s);
+
+#endif
@@ -10,8 +10,11 @@
 
 #include "cool-io.h"
 
+union YYSTYPE;
+
 extern char *cool_token_to_string(int tok);
 extern void print_cool_token(int tok);
+extern void print_cool_token(ostream& out, int tok, union YYSTYPE& yylval);
 extern void fatal_error(char *);
 extern void print_escaped_string(ostream& str, const char *s);
 extern char *pad(int);
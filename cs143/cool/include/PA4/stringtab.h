@@ -11,7 +11,9 @@
 
 #include <assert.h>
 #include <string.h>
+#include <pthread.h>
 #include "list.h"    // list template
+#include "arena.h"   // bump-pointer allocator
 #include "cool-io.h"
 
 class Entry;
@@ -31,11 +33,22 @@ protected:
   char *str;     // the string
   int  len;      // the length of the string (without trailing \0)
   int index;     // a unique index for each string
+  unsigned int hashval;  // hash of str; see hash_string below
 public:
-  Entry(char *s, int l, int i);
+  // Copy the first l characters of s into a new Entry with index i.  If
+  // an arena is given the characters are allocated from it, otherwise
+  // from the heap.
+  Entry(char *s, int l, int i, Arena *a = NULL);
+
+  // hash the first len characters of s.  Equal strings hash equally.
+  static unsigned int hash_string(char *s, int len);
 
   // is string argument equal to the str of this Entry?
   int equal_string(char *s, int len) const;  
+
+  // same as equal_string, but first rejects entries whose hash differs
+  int equal_string(char *s, int len, unsigned int h) const
+    { return (h == hashval) && equal_string(s,len); }
                          
   // is the integer argument equal to the index of this Entry?
   bool equal_index(int ind) const           { return ind == index; }
@@ -45,6 +58,8 @@ public:
   // Return the str and len components of the Entry.
   char *get_string() const;
   int get_len() const;
+  unsigned int get_hash() const             { return hashval; }
+  int get_index() const                     { return index; }
 };
 
 //
@@ -64,19 +79,24 @@ class StringEntry : public Entry {
 public:
   void code_def(ostream& str, int stringclasstag);
   void code_ref(ostream& str);
-  StringEntry(char *s, int l, int i);
+  StringEntry(char *s, int l, int i, Arena *a = NULL);
 };
 
 class IdEntry : public Entry {
 public:
-  IdEntry(char *s, int l, int i);
+  IdEntry(char *s, int l, int i, Arena *a = NULL);
 };
 
 class IntEntry: public Entry {
+protected:
+  int value;     // the integer that str represents
 public:
   void code_def(ostream& str, int intclasstag);
   void code_ref(ostream& str);
-  IntEntry(char *s, int l, int i);
+  IntEntry(char *s, int l, int i, Arena *a = NULL);
+
+  // Return the value of the integer constant, so it need not be reparsed.
+  int get_value() const                     { return value; }
 };
 
 typedef StringEntry *StringEntryP;
@@ -95,13 +115,41 @@ class StringTable
 protected:
    List<Elem> *tbl;   // a string table is a list
    int index;         // the current index
+
+   // The list is also indexed by an open-addressed hash table, so that
+   // add_string and lookup_string do not have to scan the whole list.
+   // hash_size is zero or a power of two; hash_tbl holds no more than
+   // hash_size/2 entries.
+   Elem **hash_tbl;
+   int hash_size;
+
+   // entries[i] is the Entry with index i, for 0 <= i < index.  It makes
+   // lookup by index, and so iteration with first/more/next, O(1) per entry.
+   Elem **entries;
+   int entries_size;  // allocated length of entries
+
+   // The Entrys, their strings and the list cells of tbl are allocated
+   // from this arena, each Entry immediately followed by its string.
+   Arena arena;
+
+   // If lock is set, add_string holds it while it changes the table (see
+   // make_shared).
+   pthread_mutex_t *lock;
+
+   Elem **hash_slot(char *s, int len, unsigned int h);  // find s or a free slot
+   void hash_grow();                                    // double hash_size
+   void entries_grow();                                 // double entries_size
 public:
-   StringTable(): tbl((List<Elem> *) NULL), index(0) { }   // an empty table
+   StringTable(): tbl((List<Elem> *) NULL), index(0),
+                  hash_tbl((Elem **) NULL), hash_size(0),
+                  entries((Elem **) NULL), entries_size(0),
+                  lock((pthread_mutex_t *) NULL) { } // an empty table
+   ~StringTable();
    // The following methods each add a string to the string table.  
    // Only one copy of each string is maintained.  
    // Returns a pointer to the string table entry with the string.
 
-   // add the prefix of s of length maxchars
+   // add the prefix of s of length maxchars (or up to its first null)
    Elem *add_string(char *s, int maxchars);
 
    // add the (null terminated) string s
@@ -121,6 +169,14 @@ public:
 
    void print();  // print the entire table; for debugging
 
+   // Allow add_string to be called from several threads at once.  The
+   // other methods must still not be called while strings are added.
+   void make_shared();
+
+   // Free every Entry of the table at once and make the table empty.
+   // Symbols from the table must not be used afterwards.
+   void clear();
+
 };
 
 class IdTable : public StringTable<IdEntry> { };
@@ -131,9 +187,29 @@ public:
    void code_string_table(ostream&, int classtag);
 };
 
+//
+// An IntTable also indexes its Entrys by integer value.  int_tbl maps a
+// value to the Entry holding its decimal representation (as produced by
+// add_int), so that add_int neither formats nor hashes a string when
+// the integer is already in the table.  int_tbl is open addressed like
+// hash_tbl.
+//
 class IntTable : public StringTable<IntEntry>
 {
+protected:
+   IntEntry **int_tbl;
+   int int_size;      // zero or a power of two
+   int int_count;     // number of Entrys in int_tbl
+
+   void int_grow();   // double int_size
 public:
+   IntTable(): int_tbl((IntEntry **) NULL), int_size(0), int_count(0) { }
+   ~IntTable() { delete [] int_tbl; }
+
+   // add the string representation of an integer
+   IntEntry *add_int(int i);
+
+   void clear();
    void code_string_table(ostream&, int classtag);
 };
 
@@ -13,9 +13,66 @@
 
 //
 // A string table is implemented a linked list of Entrys.  Each Entry
-// in the list has a unique string.
+// in the list has a unique string.  The Entrys are also kept in a hash
+// table (hash_tbl) so that strings can be found without scanning the list.
 //
 
+//
+// hash_slot returns the slot of hash_tbl holding the Entry for the
+// string s of length len, or the empty slot where that Entry belongs.
+// Collisions are resolved by linear probing; since the table is never
+// more than half full, an empty slot is always found.
+//
+template <class Elem>
+Elem **StringTable<Elem>::hash_slot(char *s, int len, unsigned int h)
+{
+  unsigned int mask = hash_size - 1;
+  unsigned int i = h & mask;
+  while (hash_tbl[i] && !hash_tbl[i]->equal_string(s,len,h))
+    i = (i + 1) & mask;
+  return &hash_tbl[i];
+}
+
+//
+// hash_grow doubles the size of the hash table and reinserts the Entrys.
+// The hash of each Entry is stored in the Entry, so no string is rehashed.
+//
+template <class Elem>
+void StringTable<Elem>::hash_grow()
+{
+  Elem **old_tbl = hash_tbl;
+  int old_size = hash_size;
+
+  hash_size = old_size ? 2 * old_size : 64;
+  hash_tbl = new Elem *[hash_size];
+  memset(hash_tbl, 0, hash_size * sizeof(Elem *));
+
+  unsigned int mask = hash_size - 1;
+  for (int j = 0; j < old_size; j++)
+    if (old_tbl[j]) {
+      unsigned int i = old_tbl[j]->get_hash() & mask;
+      while (hash_tbl[i])
+        i = (i + 1) & mask;
+      hash_tbl[i] = old_tbl[j];
+    }
+  delete [] old_tbl;
+}
+
+//
+// entries_grow doubles the length of the index-to-Entry array.
+//
+template <class Elem>
+void StringTable<Elem>::entries_grow()
+{
+  Elem **old_entries = entries;
+
+  entries_size = entries_size ? 2 * entries_size : 64;
+  entries = new Elem *[entries_size];
+  if (old_entries)
+    memcpy(entries, old_entries, index * sizeof(Elem *));
+  delete [] old_entries;
+}
+
 template <class Elem>
 Elem *StringTable<Elem>::add_string(char *s)
 {
@@ -23,52 +80,73 @@ Elem *StringTable<Elem>::add_string(char *s)
 }
 
 //
-// Add a string requires two steps.  First, the list is searched; if the
-// string is found, a pointer to the existing Entry for that string is 
+// The string need not be null terminated: no more than maxchars characters
+// of s are read, so s may point into a larger buffer, such as the text
+// being scanned.  The characters are copied only if a new Entry is made.
+//
+// Add a string requires two steps.  First, the hash table is searched; if
+// the string is found, a pointer to the existing Entry for that string is 
 // returned.  If the string is not found, a new Entry is created and added
-// to the list.
+// to the list and to the hash table.  The string is hashed before the lock
+// of a shared table is taken.
 //
 template <class Elem>
 Elem *StringTable<Elem>::add_string(char *s, int maxchars)
 {
-  int len = min((int) strlen(s),maxchars);
-  for(List<Elem> *l = tbl; l; l = l->tl())
-    if (l->hd()->equal_string(s,len))
-      return l->hd();
+  int len = strnlen(s,maxchars);
+  unsigned int h = Entry::hash_string(s,len);
+
+  if (lock)
+    pthread_mutex_lock(lock);
+
+  if (2 * (index + 1) > hash_size)
+    hash_grow();
+
+  Elem **slot = hash_slot(s,len,h);
+  Elem *e = *slot;
+  if (e == NULL) {
+    if (index == entries_size)
+      entries_grow();
 
-  Elem *e = new Elem(s,len,index++);
-  tbl = new List<Elem>(e, tbl);
+    e = new (arena) Elem(s,len,index,&arena);
+    entries[index++] = e;
+    tbl = new (arena) List<Elem>(e, tbl);
+    *slot = e;
+  }
+
+  if (lock)
+    pthread_mutex_unlock(lock);
   return e;
 }
 
 //
-// To look up a string, the list is scanned until a matching Entry is located.
-// If no such entry is found, an assertion failure occurs.  Thus, this function
-// is used only for strings that one expects to find in the table.
+// To look up a string, the hash table is probed until a matching Entry is
+// located.  If no such entry is found, an assertion failure occurs.  Thus,
+// this function is used only for strings that one expects to find in the
+// table.
 //
 template <class Elem>
 Elem *StringTable<Elem>::lookup_string(char *s)
 {
   int len = strlen(s);
-  for(List<Elem> *l = tbl; l; l = l->tl())
-    if (l->hd()->equal_string(s,len))
-      return l->hd();
+  if (hash_size) {
+    Elem *e = *hash_slot(s,len,Entry::hash_string(s,len));
+    if (e)
+      return e;
+  }
   assert(0);   // fail if string is not found
   return NULL; // to avoid compiler warning
 }
 
 //
 // lookup is similar to lookup_string, but uses the index of the string
-// as the key.
+// as the key.  The index is a position in the entries array.
 //
 template <class Elem>
 Elem *StringTable<Elem>::lookup(int ind)
 {
-  for(List<Elem> *l = tbl; l; l = l->tl())
-    if (l->hd()->equal_index(ind))
-      return l->hd();
-  assert(0);   // fail if string is not found
-  return NULL; // to avoid compiler warning
+  assert(0 <= ind && ind < index);   // fail if string is not found
+  return entries[ind];
 }
 
 //
@@ -77,8 +155,8 @@ Elem *StringTable<Elem>::lookup(int ind)
 template <class Elem>
 Elem *StringTable<Elem>::add_int(int i)
 {
-  static char *buf = new char[20];
-  snprintf(buf, 20, "%d", i);
+  char buf[20];
+  snprintf(buf, sizeof(buf), "%d", i);
   return add_string(buf);
 }
 template <class Elem>
@@ -105,3 +183,36 @@ void StringTable<Elem>::print()
 {
   list_print(cerr,tbl);
 }
+
+template <class Elem>
+void StringTable<Elem>::clear()
+{
+  delete [] hash_tbl;
+  delete [] entries;
+  arena.release();
+  tbl = (List<Elem> *) NULL;
+  index = 0;
+  hash_tbl = (Elem **) NULL;
+  hash_size = 0;
+  entries = (Elem **) NULL;
+  entries_size = 0;
+}
+
+template <class Elem>
+void StringTable<Elem>::make_shared()
+{
+  if (lock == NULL) {
+    lock = new pthread_mutex_t;
+    pthread_mutex_init(lock, NULL);
+  }
+}
+
+template <class Elem>
+StringTable<Elem>::~StringTable()
+{
+  clear();
+  if (lock) {
+    pthread_mutex_destroy(lock);
+    delete lock;
+  }
+}
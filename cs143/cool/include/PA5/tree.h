@@ -17,6 +17,8 @@
 
 #include "stringtab.h"
 #include "cool-io.h"
+#include "arena.h"
+#include <iterator>
 
 /////////////////////////////////////////////////////////////////////
 //
@@ -47,12 +49,50 @@
 //           sets the line number and type of "this" to the values in
 //           the argument tree_node.  Returns "this".
 //
+//   Tree nodes are not allocated one at a time on the heap but from an
+//   Arena (see arena.h): "new" on any tree_node allocates from
+//   node_arena, so the nodes of a tree lie together in memory in the
+//   order they were made.  Nodes are never deleted one at a time.
+//
+//       Arena *node_arena
+//         the arena new nodes are allocated from; at first the arena of
+//         the compilation.
+//
+//       Arena *set_node_arena(Arena *a)
+//         makes a the arena new nodes are allocated from, and returns the
+//         previous one.  This can be used to give each class an arena of
+//         its own.
+//
+//       T copy_into(Arena *a, T t)
+//         returns a deep copy of the tree t (with its copy_* method)
+//         allocated from a.
+//
+//       void release_nodes()
+//         frees every node of the compilation arena, when the compilation
+//         is done with them.
+//
+//   node_arena, and node_line, from which new nodes take their line
+//   number, are per thread, so that parsers on several threads (see
+//   parse-context.h) can make nodes at once.  A thread starts with the
+//   compilation arena and the global node_lineno; one that makes nodes
+//   alongside others must set both to its own.
 //
 ////////////////////////////////////////////////////////////////////////////
+
+extern thread_local Arena *node_arena;
+extern thread_local int *node_line;
+Arena *set_node_arena(Arena *a);
+void release_nodes();
+
 class tree_node {
 protected:
     int line_number;            // stash the line number when node is made
 public:
+    static void *operator new(size_t size) { return node_arena->alloc(size); }
+    static void *operator new(size_t size, Arena &a) { return a.alloc(size); }
+    static void operator delete(void *) { }
+    static void operator delete(void *, Arena &) { }
+
     tree_node();
     virtual tree_node *copy() = 0;
     virtual ~tree_node() { }
@@ -61,6 +101,14 @@ public:
     tree_node *set(tree_node *);
 };
 
+template <class T> T copy_into(Arena *a, T t)
+{
+    Arena *old = set_node_arena(a);
+    T copy = (T) t->copy();
+    set_node_arena(old);
+    return copy;
+}
+
 ///////////////////////////////////////////////////////////////////
 //
 //  Lists of APS objects are implemented by the "list_node"
@@ -89,15 +137,30 @@ public:
 //     for(int i = l->first(); l->more(i); i = l->next(i))
 //         ... operate on l->nth(i) ...
 //
-//      
+//     iterator begin();
+//     iterator end();
+//       A forward iterator over the elements of the list.  nth(i) may
+//     take time proportional to the depth of the list, which for a list
+//     built by appending one element at a time is its length; the
+//     iterator visits the whole list in time proportional to its length
+//     however it was built, and should be preferred:
+//
+//     for(Classes_class::iterator i = l->begin(); i != l->end(); ++i)
+//         ... operate on *i ...
+//
 //     int len()
-//     returns the length of the list
+//     returns the length of the list, in constant time
 //
 //     nth_length(int n, int &len);
 //     Returns the nth element of the list or NULL if there are not n elements.
 //     "len" is set to the length of the list.  This method is used internally
 //     by the APS package to efficiently traverse the list representation.  
 //
+//     int split(list_node<Elem> *&l1, list_node<Elem> *&l2);
+//     If the list is the append of two lists, sets l1 and l2 to them and
+//     returns true; otherwise returns false.  This method is used by the
+//     iterator.
+//
 //     static list_node<Elem> *nil();
 //     static list_node<Elem> *single(Elem);
 //     static list_node<Elem> *append(list_node<Elem> *, list_node<Elem> *);
@@ -110,10 +173,23 @@ public:
 //     list_node<Elem>::single(e);     where "e" has type Elem
 //     list_node<Elem>::append(l1,l2);
 //
+//     list_node<Elem> *extend(Elem e);
+//     returns a list of the elements of this list followed by e.  The
+//     first call copies the elements into a vector_list_node, whose
+//     extend adds e in place and returns the same list, so a list built
+//     up one element at a time (as the parser does) is a single array
+//     rather than a chain of append_nodes.  A list that has been extended
+//     must not be used again except through the list extend returns, and
+//     a list that is part of another must not be extended.
+//
 //////////////////////////////////////////////////////////////////////////////
 
+template <class Elem> class list_iterator;
+
 template <class Elem> class list_node : public tree_node {
 public:
+    typedef list_iterator<Elem> iterator;
+
     tree_node *copy()            { return copy_list(); }
     Elem nth(int n);
     //
@@ -123,10 +199,15 @@ public:
     int next(int n)  { return n + 1; }
     int more(int n)  { return (n < len()); }
 
+    iterator begin();
+    iterator end();
+
     virtual list_node<Elem> *copy_list() = 0;
     virtual ~list_node() { }
     virtual int len() = 0;
     virtual Elem nth_length(int n, int &len) = 0;
+    virtual list_node<Elem> *extend(Elem e);
+    virtual int split(list_node<Elem> *&, list_node<Elem> *&) { return 0; }
 
     static list_node<Elem> *nil();
     static list_node<Elem> *single(Elem);
@@ -158,25 +239,121 @@ public:
 };
 
 
+//
+// The length of an append_node is computed when it is made.  A NULL
+// part, which some parsers make after a syntax error, counts as empty.
+//
 template <class Elem> class append_node : public list_node<Elem> {
 private:
     list_node<Elem> *some, *rest;
+    int length;
 public:
     append_node(list_node<Elem> *l1, list_node<Elem> *l2) {
 	some = l1;
 	rest = l2;
+	length = (l1 ? l1->len() : 0) + (l2 ? l2->len() : 0);
     }
     list_node<Elem> *copy_list();
     int len();
     Elem nth(int n);
     Elem nth_length(int n, int &len);
+    int split(list_node<Elem> *&l1, list_node<Elem> *&l2);
     void dump(ostream& stream, int n);
 };
 
 
+//
+// A list whose elements are held in an array, so that len and nth take
+// constant time.  extend adds to the array in place, doubling it as
+// needed.  The array is allocated from the arena of the list node.
+//
+template <class Elem> class vector_list_node : public list_node<Elem> {
+private:
+    Elem *elems;
+    int count;                  // the number of elements
+    int size;                   // the allocated length of elems
+    Arena *arena;               // the arena elems are allocated from
+public:
+    vector_list_node() {
+	elems = NULL;
+	count = size = 0;
+	arena = node_arena;
+    }
+    list_node<Elem> *copy_list();
+    int len();
+    Elem nth_length(int n, int &len);
+    list_node<Elem> *extend(Elem e);
+    void dump(ostream& stream, int n);
+};
+
+
+//
+// A forward iterator over a list.  Appended lists are visited left to
+// right with a stack of the right-hand parts still to visit; the
+// elements of other lists are fetched with nth_length.  Elements that
+// are NULL are visited like any other.
+//
+template <class Elem> class list_iterator {
+private:
+    list_node<Elem> **stack;    // lists still to visit, the next on top
+    int depth;                  // the number of lists on the stack
+    int size;                   // the allocated length of stack
+    list_node<Elem> *leaf;      // the list holding the current element,
+				// or NULL at the end
+    int index;                  // the index of the element in leaf
+    int leaf_len;               // the length of leaf
+
+    void push(list_node<Elem> *l);
+    void find(list_node<Elem> *l);
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Elem value_type;
+    typedef ptrdiff_t difference_type;
+    typedef Elem *pointer;
+    typedef Elem reference;
+
+    list_iterator() {
+	stack = NULL;
+	depth = size = 0;
+	leaf = NULL;
+	index = leaf_len = 0;
+    }
+    list_iterator(list_node<Elem> *l) {
+	stack = NULL;
+	depth = size = 0;
+	find(l);
+    }
+    list_iterator(const list_iterator<Elem> &i) {
+	stack = NULL;
+	size = 0;
+	*this = i;
+    }
+    ~list_iterator() { delete [] stack; }
+    list_iterator<Elem> &operator=(const list_iterator<Elem> &i);
+
+    Elem operator*() {
+	int len;
+	return leaf->nth_length(index, len);
+    }
+    list_iterator<Elem> &operator++();
+    list_iterator<Elem> operator++(int) {
+	list_iterator<Elem> old = *this;
+	++*this;
+	return old;
+    }
+    bool operator==(const list_iterator<Elem> &i) const {
+	return leaf == i.leaf && index == i.index && depth == i.depth;
+    }
+    bool operator!=(const list_iterator<Elem> &i) const {
+	return !(*this == i);
+    }
+};
+
+
 template <class Elem> single_list_node<Elem> *list(Elem x);
 template <class Elem> append_node<Elem> *cons(Elem x, list_node<Elem> *l);
 template <class Elem> append_node<Elem> *xcons(list_node<Elem> *l, Elem x);
+template <class Elem> list_node<Elem> *extend(list_node<Elem> *l, Elem x);
 
 
 template <class Elem> list_node<Elem> *list_node<Elem>::nil() { return new nil_node<Elem>(); }
@@ -221,6 +398,38 @@ template <class Elem> Elem append_node<Elem>::nth(int n)
     }
 }
 
+///////////////////////////////////////////////////////////////////////////
+//
+// list_node::begin, list_node::end
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> list_iterator<Elem> list_node<Elem>::begin()
+{
+    return list_iterator<Elem>(this);
+}
+
+template <class Elem> list_iterator<Elem> list_node<Elem>::end()
+{
+    return list_iterator<Elem>();
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// list_node::extend
+//
+// copy the list into a vector_list_node and add e to it
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> list_node<Elem> *list_node<Elem>::extend(Elem e)
+{
+    vector_list_node<Elem> *v = new vector_list_node<Elem>();
+
+    v->set(this);
+    for (iterator i = begin(); i != end(); ++i)
+      v->extend(*i);
+    return v->extend(e);
+}
+
 ///////////////////////////////////////////////////////////////////////////
 //
 // nil_node::copy_list
@@ -353,7 +562,7 @@ template <class Elem> list_node<Elem> *append_node<Elem>::copy_list()
 ///////////////////////////////////////////////////////////////////////////
 template <class Elem> int append_node<Elem>::len()
 {
-    return some->len() + rest->len();
+    return length;
 }
 
 
@@ -366,14 +575,32 @@ template <class Elem> int append_node<Elem>::len()
 ///////////////////////////////////////////////////////////////////////////
 template <class Elem> Elem append_node<Elem>::nth_length(int n, int &len)
 {
-    int rlen;
-    Elem tmp = some->nth_length(n, len);
+    int slen = some ? some->len() : 0;
+    int sublen;
 
-    if (!tmp) {
-	tmp = rest->nth_length(n-len, rlen);
-	len += rlen;
-    }
-    return tmp;
+    len = length;
+    if (n < 0 || n >= length)
+	return NULL;
+    else if (n < slen)
+	return some->nth_length(n, sublen);
+    else
+	return rest->nth_length(n - slen, sublen);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// append_node::split
+//
+// return the two lists appended
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> int append_node<Elem>::split(list_node<Elem> *&l1,
+						   list_node<Elem> *&l2)
+{
+    l1 = some;
+    l2 = rest;
+    return 1;
 }
 
 
@@ -386,16 +613,189 @@ template <class Elem> Elem append_node<Elem>::nth_length(int n, int &len)
 ///////////////////////////////////////////////////////////////////////////
 template <class Elem> void append_node<Elem>::dump(ostream& stream, int n)
 {
-    int i, size;
+    stream << pad(n) << "list\n";
+    for (list_iterator<Elem> i = this->begin(); i != this->end(); ++i)
+      (*i)->dump(stream, n+2);
+    stream << pad(n) << "(end_of_list)\n";
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::copy_list
+//
+// return the deep copy of the vector_list_node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> list_node<Elem> *vector_list_node<Elem>::copy_list()
+{
+    vector_list_node<Elem> *v = new vector_list_node<Elem>();
+    int i;
+
+    for (i = 0; i < count; i++)
+      v->extend((Elem) elems[i]->copy());
+    return v;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::len
+//
+// return the length of the vector_list_node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> int vector_list_node<Elem>::len()
+{
+    return count;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::nth_length
+//
+// return the nth element on the list
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> Elem vector_list_node<Elem>::nth_length(int n, int &len)
+{
+    len = count;
+    if (n < 0 || n >= count)
+	return NULL;
+    else
+	return elems[n];
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::extend
+//
+// add e to the end of the list, in place
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> list_node<Elem> *vector_list_node<Elem>::extend(Elem e)
+{
+    if (count == size) {
+	int new_size = size ? 2 * size : 4;
+	Elem *new_elems = (Elem *) arena->alloc(new_size * sizeof(Elem));
+	for (int i = 0; i < count; i++)
+	  new_elems[i] = elems[i];
+	elems = new_elems;
+	size = new_size;
+    }
+    elems[count++] = e;
+    return this;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::dump
+//
+// dump for list node, as for an append_node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> void vector_list_node<Elem>::dump(ostream& stream, int n)
+{
+    int i;
 
-    size = len();
     stream << pad(n) << "list\n";
-    for (i = 0; i < size; i++)
-      nth(i)->dump(stream, n+2);
+    for (i = 0; i < count; i++)
+      elems[i]->dump(stream, n+2);
     stream << pad(n) << "(end_of_list)\n";
 }
 
 
+///////////////////////////////////////////////////////////////////////////
+//
+// list_iterator::operator=
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem>
+list_iterator<Elem> &list_iterator<Elem>::operator=(const list_iterator<Elem> &i)
+{
+    if (this == &i)
+	return *this;
+    depth = 0;
+    for (int k = 0; k < i.depth; k++)
+      push(i.stack[k]);
+    leaf = i.leaf;
+    index = i.index;
+    leaf_len = i.leaf_len;
+    return *this;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// list_iterator::push
+//
+// push l on the stack, doubling it as needed
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> void list_iterator<Elem>::push(list_node<Elem> *l)
+{
+    if (depth == size) {
+	int new_size = size ? 2 * size : 16;
+	list_node<Elem> **new_stack = new list_node<Elem> *[new_size];
+	for (int k = 0; k < depth; k++)
+	  new_stack[k] = stack[k];
+	delete [] stack;
+	stack = new_stack;
+	size = new_size;
+    }
+    stack[depth++] = l;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// list_iterator::find
+//
+// move to the first element of l, or if it is empty (or NULL) to the
+// first element of the lists on the stack, or to the end
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> void list_iterator<Elem>::find(list_node<Elem> *l)
+{
+    list_node<Elem> *l1, *l2;
+
+    for (;;) {
+	while (l && l->split(l1, l2)) {
+	    push(l2);
+	    l = l1;
+	}
+	if (l && l->len() > 0) {
+	    leaf = l;
+	    index = 0;
+	    leaf_len = l->len();
+	    return;
+	}
+	if (depth == 0) {
+	    leaf = NULL;
+	    index = leaf_len = 0;
+	    return;
+	}
+	l = stack[--depth];
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// list_iterator::operator++
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> list_iterator<Elem> &list_iterator<Elem>::operator++()
+{
+    if (++index >= leaf_len)
+	find(NULL);
+    return *this;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////
 //
 // list
@@ -428,4 +828,20 @@ template <class Elem> append_node<Elem> *xcons(list_node<Elem> *l, Elem x)
     return new append_node<Elem>(l, list(x));
 }
 
+
+///////////////////////////////////////////////////////////////////////////
+//
+// extend
+//
+// l->extend(x), where a NULL l (as left by the parser's error rules) is
+// taken to be empty
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> list_node<Elem> *extend(list_node<Elem> *l, Elem x)
+{
+    if (l == NULL)
+	l = new nil_node<Elem>();
+    return l->extend(x);
+}
+
 #endif /* TREE_H */
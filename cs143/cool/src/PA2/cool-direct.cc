@@ -0,0 +1,789 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//  cool-direct.cc
+//
+//  A direct-coded Cool scanner.
+//
+//  This is a replacement for the scanner flex generates from cool.flex,
+//  with the same interface (cool-lex.h) and the same tokens, line numbers
+//  and error messages.  Where the flex scanner looks each character up
+//  in its transition tables, this one is written out as code: a switch on
+//  the first character of a token picks the rule, and identifiers,
+//  integers, white space, comment text and string text are consumed by
+//  tight loops over a table of character classes.  Keywords are found by
+//  the perfect hash of cool-keywords.h.  Build it with "make
+//  lexer-direct" (see the Makefile).
+//
+//  The rules are those of cool.flex, in its order, and with its start
+//  conditions: the comments below name the flex rule each piece of code
+//  implements.  As in flex, a token is the longest text some rule
+//  matches, so "(*" begins a comment rather than being "(" and "*", and
+//  "class1" is an identifier.
+//
+//  The scanner works on text in memory, ending in a NUL.  A mapped file
+//  (cool_lex_map_file) or a text set with cool_lex_set_text is scanned in
+//  place.  Otherwise the input is read from fin to its end when the first
+//  token is asked for, and released when the end is reached, so that the
+//  next call reads fin afresh, as the flex scanner does.  A NUL before
+//  the end is a character of the text; only the NUL at the end is the
+//  end of the input.
+//
+//  yy_flex_debug is accepted but has no effect.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "cool-parse.h"
+#include "cool-lex.h"
+#include "cool-keywords.h"
+#include "stringtab.h"
+#include "utilities.h"
+
+extern FILE *fin;
+extern int curr_lineno;
+extern YYSTYPE cool_yylval;
+
+int yy_flex_debug;
+
+//
+// The start conditions, numbered as flex numbers them, so that they can
+// be stored in checkpoints and passed to cool_lex_set_text by either
+// scanner.
+//
+enum { INITIAL, COMMENT, STRING, BROKENSTRING };
+
+struct direct_scanner {
+  const char *cur;       // the next character
+  const char *lim;       // the end of the text; *lim is a NUL
+  char *owned;           // the text, if read from fin, else NULL
+  bool active;           // there is a text to scan
+  int start;             // the start condition
+};
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Character classes
+//
+//////////////////////////////////////////////////////////////////////
+
+enum {
+  C_ID    = 1,           // [a-zA-Z0-9_]
+  C_DIGIT = 2,           // [0-9]
+  C_SPACE = 4,           // [ \n\r\t\v\f]
+  C_STR   = 8,           // ends a run of string text: [\\\"\n\0]
+  C_COMM  = 16,          // ends a run of comment text: [*(\n\0]
+  C_BROKE = 32           // ends a run of broken string: [\\\"\n\0]
+};
+
+struct CharClasses {
+  unsigned char c[256];
+};
+
+constexpr CharClasses make_classes()
+{
+  CharClasses t = { };
+  for (int i = 0; i < 256; i++) {
+    if ((i >= 'a' && i <= 'z') || (i >= 'A' && i <= 'Z') || i == '_')
+      t.c[i] |= C_ID;
+    if (i >= '0' && i <= '9')
+      t.c[i] |= C_ID | C_DIGIT;
+  }
+  const char *space = " \n\r\t\v\f";
+  for (int i = 0; space[i]; i++)
+    t.c[(unsigned char) space[i]] |= C_SPACE;
+  t.c['\\'] |= C_STR | C_BROKE;
+  t.c['"'] |= C_STR | C_BROKE;
+  t.c['\n'] |= C_STR | C_COMM | C_BROKE;
+  t.c[0] |= C_STR | C_COMM | C_BROKE;
+  t.c['*'] |= C_COMM;
+  t.c['('] |= C_COMM;
+  return t;
+}
+
+static constexpr CharClasses classes = make_classes();
+
+static inline bool is(char c, int cls)
+{
+  return classes.c[(unsigned char) c] & cls;
+}
+
+//
+// The message of the error token for a character no rule matches: the
+// character itself, as yytext would be.
+//
+struct SingleChars {
+  char s[256][2];
+};
+
+constexpr SingleChars make_single_chars()
+{
+  SingleChars t = { };
+  for (int i = 0; i < 256; i++)
+    t.s[i][0] = (char) i;
+  return t;
+}
+
+static constexpr SingleChars single_chars = make_single_chars();
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Strings
+//
+//////////////////////////////////////////////////////////////////////
+
+//
+// As strTooLong and strLenErr in cool.flex: if n more characters do not
+// fit in string_buf, skip the rest of the string and return true.
+//
+static bool str_too_long(cool_lex_state *ls, direct_scanner *s, int n)
+{
+  if (ls->string_length + n >= MAX_STR_CONST) {
+    s->start = BROKENSTRING;
+    return true;
+  }
+  return false;
+}
+
+static void reset_str(cool_lex_state *ls)
+{
+  ls->string_length = 0;
+  ls->string_buf[0] = '\0';
+}
+
+static int str_len_err(cool_lex_state *ls)
+{
+  reset_str(ls);
+  ls->lval.error_msg = "String constant too long";
+  return ERROR;
+}
+
+static inline void add_to_str(cool_lex_state *ls, const char *str, int n)
+{
+  memcpy(ls->string_buf + ls->string_length, str, n);
+  ls->string_length += n;
+}
+
+static inline void add_to_str(cool_lex_state *ls, char c)
+{
+  ls->string_buf[ls->string_length++] = c;
+}
+
+static int count_lines(const char *s, int n)
+{
+  const char *end = s + n;
+  int lines = 0;
+  while ((s = (const char *) memchr(s, '\n', end - s)) != NULL) {
+    lines++;
+    s++;
+  }
+  return lines;
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Input
+//
+//////////////////////////////////////////////////////////////////////
+
+//
+// Read all of fin into memory.
+//
+static void read_input(cool_lex_state *ls, direct_scanner *s)
+{
+  size_t size = 64 * 1024, len = 0, n;
+  char *buf = (char *) malloc(size);
+  while ((n = fread(buf + len, 1, size - len - 1, ls->fin)) > 0) {
+    len += n;
+    if (size - len <= 1) {
+      size *= 2;
+      buf = (char *) realloc(buf, size);
+    }
+  }
+  if (ferror(ls->fin)) {
+    cerr << "read() in scanner failed\n";
+    exit(1);
+  }
+  buf[len] = '\0';
+  s->owned = buf;
+  s->cur = buf;
+  s->lim = buf + len;
+  s->active = true;
+}
+
+//
+// The end of the input has been reached.  Text read from fin is released,
+// so that the next token is read from fin again; mapped files and texts
+// set with cool_lex_set_text stay at their end.
+//
+static void end_input(direct_scanner *s)
+{
+  if (s->owned) {
+    free(s->owned);
+    s->owned = NULL;
+    s->active = false;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  The scanner
+//
+//////////////////////////////////////////////////////////////////////
+
+// Called before each action, as YY_USER_ACTION is in cool.flex.
+#define MATCHED(start) \
+  if (ls->checkpoints) \
+    cool_lex_note_lines(ls, start, tok, p - tok)
+
+static int scan(cool_lex_state *ls, direct_scanner *s)
+{
+  YYSTYPE &lval = ls->lval;
+  const char *p = s->cur;
+  const char *lim = s->lim;
+
+  for (;;) {
+    const char *tok = p;
+    char c = *p;
+
+    switch (s->start) {
+
+    case INITIAL:
+      //
+      // [ \n\r\t\v\f]+
+      //
+      if (is(c, C_SPACE)) {
+        int lines = 0;
+        do {
+          lines += (*p++ == '\n');
+        } while (is(*p, C_SPACE));
+        MATCHED(INITIAL);
+        ls->lineno += lines;
+        continue;
+      }
+
+      //
+      // Keywords, [A-Z]{ALPHANUMERIC}* and [a-z]{ALPHANUMERIC}*
+      //
+      if (is(c, C_ID) && !is(c, C_DIGIT) && c != '_') {
+        do {
+          p++;
+        } while (is(*p, C_ID));
+        MATCHED(INITIAL);
+        s->cur = p;
+        int token = cool_keyword(tok, p - tok, &lval);
+        if (token)
+          return token;
+        lval.symbol = idtable.add_string((char *) tok, p - tok);
+        return c <= 'Z' ? TYPEID : OBJECTID;
+      }
+
+      //
+      // {NUMBER}+
+      //
+      if (is(c, C_DIGIT)) {
+        do {
+          p++;
+        } while (is(*p, C_DIGIT));
+        MATCHED(INITIAL);
+        s->cur = p;
+        lval.symbol = inttable.add_string((char *) tok, p - tok);
+        return INT_CONST;
+      }
+
+      switch (c) {
+      case '\0':
+        if (p == lim) {
+          s->cur = p;
+          end_input(s);
+          return 0;
+        }
+        break;                      // to the . rule
+
+      case '"': {
+        //
+        // \"[^\\\"\n\0]*\" and \"
+        //
+        const char *q = p + 1;
+        while (!is(*q, C_STR))
+          q++;
+        if (*q == '"') {
+          p = q + 1;
+          MATCHED(INITIAL);
+          s->cur = p;
+          int len = q - tok - 1;
+          if (len >= MAX_STR_CONST) {
+            lval.error_msg = "String constant too long";
+            return ERROR;
+          }
+          lval.symbol = stringtable.add_string((char *) tok + 1, len);
+          return STR_CONST;
+        }
+        p++;
+        MATCHED(INITIAL);
+        s->start = STRING;
+        continue;
+      }
+
+      case '(':
+        if (p[1] == '*') {          // "(*"
+          p += 2;
+          MATCHED(INITIAL);
+          ls->comment_depth++;
+          s->start = COMMENT;
+          continue;
+        }
+        p++;
+        MATCHED(INITIAL);
+        s->cur = p;
+        return '(';
+
+      case '*':
+        if (p[1] == ')') {          // "*)"
+          p += 2;
+          MATCHED(INITIAL);
+          s->cur = p;
+          lval.error_msg = "Unmatched *)";
+          return ERROR;
+        }
+        p++;
+        MATCHED(INITIAL);
+        s->cur = p;
+        return '*';
+
+      case '-':
+        if (p[1] == '-') {          // "--".*\n and "--".*
+          const char *nl = (const char *) memchr(p + 2, '\n', lim - p - 2);
+          p = nl ? nl + 1 : lim;
+          MATCHED(INITIAL);
+          ls->lineno++;
+          continue;
+        }
+        p++;
+        MATCHED(INITIAL);
+        s->cur = p;
+        return '-';
+
+      case '=':
+        if (p[1] == '>') {          // {DARROW}
+          p += 2;
+          MATCHED(INITIAL);
+          s->cur = p;
+          return DARROW;
+        }
+        p++;
+        MATCHED(INITIAL);
+        s->cur = p;
+        return '=';
+
+      case '<':
+        if (p[1] == '-' || p[1] == '=') {
+          p += 2;
+          MATCHED(INITIAL);
+          s->cur = p;
+          return tok[1] == '-' ? ASSIGN : LE;
+        }
+        p++;
+        MATCHED(INITIAL);
+        s->cur = p;
+        return '<';
+
+      case '/': case '+': case ')': case '.': case '~': case ',':
+      case ';': case ':': case '@': case '{': case '}':
+        p++;
+        MATCHED(INITIAL);
+        s->cur = p;
+        return c;
+      }
+
+      //
+      // .
+      //
+      p++;
+      MATCHED(INITIAL);
+      s->cur = p;
+      lval.error_msg = (char *) single_chars.s[(unsigned char) c];
+      return ERROR;
+
+    case COMMENT:
+      if (c == '(' && p[1] == '*') {         // "(*"
+        p += 2;
+        MATCHED(COMMENT);
+        ls->comment_depth++;
+        continue;
+      }
+      if (c == '*' && p[1] == ')') {         // "*)"
+        p += 2;
+        MATCHED(COMMENT);
+        if (--ls->comment_depth == 0)
+          s->start = INITIAL;
+        continue;
+      }
+      if (c == '\0' && p == lim) {           // <<EOF>>
+        s->start = INITIAL;
+        ls->comment_depth = 0;
+        s->cur = p;
+        end_input(s);
+        lval.error_msg = "EOF in comment";
+        return ERROR;
+      }
+      if (c == '*' || c == '(') {            // .
+        p++;
+        MATCHED(COMMENT);
+        continue;
+      }
+      {                                      // [^*(]+
+        int lines = 0;
+        for (;;) {
+          while (!is(*p, C_COMM))
+            p++;
+          if (*p == '\n')
+            lines++;
+          else if (*p != '\0' || p == lim)
+            break;
+          p++;
+        }
+        MATCHED(COMMENT);
+        ls->lineno += lines;
+      }
+      continue;
+
+    case STRING:
+      switch (c) {
+      case '"':
+        p++;
+        MATCHED(STRING);
+        s->cur = p;
+        ls->string_buf[ls->string_length] = '\0';
+        lval.symbol = stringtable.add_string(ls->string_buf,
+                                             ls->string_length);
+        reset_str(ls);
+        s->start = INITIAL;
+        return STR_CONST;
+
+      case '\0':
+        if (p == lim) {                      // <<EOF>>
+          s->start = INITIAL;
+          reset_str(ls);
+          s->cur = p;
+          end_input(s);
+          lval.error_msg = "EOF in string constant";
+          return ERROR;
+        }
+        p++;                                 // \0
+        MATCHED(STRING);
+        s->cur = p;
+        lval.error_msg = "String contains null character";
+        reset_str(ls);
+        s->start = BROKENSTRING;
+        return ERROR;
+
+      case '\\': {
+        char d = p[1];
+        if (d == '\0' && p + 1 < lim) {      // \\\0
+          p += 2;
+          MATCHED(STRING);
+          s->cur = p;
+          lval.error_msg = "String contains null character";
+          reset_str(ls);
+          s->start = BROKENSTRING;
+          return ERROR;
+        }
+        if (d == '\0') {                     // . at the end of the input
+          p++;
+          MATCHED(STRING);
+          if (str_too_long(ls, s, 1)) {
+            s->cur = p;
+            return str_len_err(ls);
+          }
+          add_to_str(ls, c);
+          continue;
+        }
+        p += 2;                              // \\\n, \\n, \\t, \\b, \\f, \\.
+        MATCHED(STRING);
+        if (str_too_long(ls, s, 1)) {
+          s->cur = p;
+          return str_len_err(ls);
+        }
+        switch (d) {
+        case '\n': ls->lineno++; break;
+        case 'n':  d = '\n'; break;
+        case 't':  d = '\t'; break;
+        case 'b':  d = '\b'; break;
+        case 'f':  d = '\f'; break;
+        }
+        add_to_str(ls, d);
+        continue;
+      }
+
+      case '\n':
+        p++;
+        MATCHED(STRING);
+        s->cur = p;
+        ls->lineno++;
+        s->start = INITIAL;
+        reset_str(ls);
+        lval.error_msg = "Unterminated string constant";
+        return ERROR;
+
+      default: {                             // [^\\\"\n\0]+
+        do {
+          p++;
+        } while (!is(*p, C_STR));
+        MATCHED(STRING);
+        int n = p - tok;
+        if (str_too_long(ls, s, n)) {
+          s->cur = p;
+          return str_len_err(ls);
+        }
+        add_to_str(ls, tok, n);
+        continue;
+      }
+      }
+
+    case BROKENSTRING:
+      switch (c) {
+      case '"':
+        p++;
+        MATCHED(BROKENSTRING);
+        s->start = INITIAL;
+        continue;
+
+      case '\n':
+        p++;
+        MATCHED(BROKENSTRING);
+        ls->lineno++;
+        s->start = INITIAL;
+        continue;
+
+      case '\\':
+        if (p[1] == '\n') {                  // \\\n
+          p += 2;
+          MATCHED(BROKENSTRING);
+          ls->lineno++;
+        } else {                             // \\. and \\ at the end
+          p += (p[1] == '\0' && p + 1 == lim) ? 1 : 2;
+          MATCHED(BROKENSTRING);
+        }
+        continue;
+
+      case '\0':
+        if (p == lim) {                      // <<EOF>>
+          s->start = INITIAL;
+          reset_str(ls);
+          s->cur = p;
+          end_input(s);
+          return 0;
+        }
+        // fall through
+      default:                               // [^\\\"\n]+
+        for (;;) {
+          do {
+            p++;
+          } while (!is(*p, C_BROKE));
+          if (*p != '\0' || p == lim)
+            break;
+        }
+        MATCHED(BROKENSTRING);
+        continue;
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Scanner instances
+//
+//////////////////////////////////////////////////////////////////////
+
+static direct_scanner *scanner_of(cool_lex_state *ls)
+{
+  return (direct_scanner *) ls->scanner;
+}
+
+cool_lex_state *cool_lex_new(FILE *f)
+{
+  cool_lex_state *ls = new cool_lex_state;
+  ls->fin = f;
+  ls->lineno = 1;
+  ls->comment_depth = 0;
+  reset_str(ls);
+  ls->file_buffer = NULL;
+  ls->fin_buffer = NULL;
+  ls->file_base = NULL;
+  ls->file_len = 0;
+  ls->file_mapped = false;
+  ls->text_buffer = NULL;
+  ls->text_base = NULL;
+  ls->checkpoints = NULL;
+  ls->ntokens = 0;
+
+  direct_scanner *s = new direct_scanner;
+  s->cur = s->lim = NULL;
+  s->owned = NULL;
+  s->active = false;
+  s->start = INITIAL;
+  ls->scanner = s;
+  return ls;
+}
+
+void cool_lex_delete(cool_lex_state *ls)
+{
+  direct_scanner *s = scanner_of(ls);
+  if (ls->file_base)
+    cool_lex_unmap_file(ls);
+  free(s->owned);
+  delete s;
+  delete ls;
+}
+
+int cool_lex(cool_lex_state *ls)
+{
+  direct_scanner *s = scanner_of(ls);
+  if (!s->active)
+    read_input(ls, s);
+  return scan(ls, s);
+}
+
+int cool_lex_tokens(cool_lex_state *ls, TokenBuffer &buf, int max)
+{
+  direct_scanner *s = scanner_of(ls);
+  int n, token;
+  for (n = 0; n < max; n++) {
+    if (!s->active)
+      read_input(ls, s);
+    if ((token = scan(ls, s)) == 0)
+      break;
+    buf.add(token, ls->lineno, ls->lval);
+  }
+  return n;
+}
+
+//
+// Whole-file input, as in cool.flex, except that the scanner needs only
+// one NUL after the text, and does not write to it.
+//
+bool cool_lex_map_file(cool_lex_state *ls, FILE *f)
+{
+  struct stat st;
+  int fd = fileno(f);
+
+  if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode))
+    return false;
+
+  size_t size = st.st_size;
+  size_t page = sysconf(_SC_PAGESIZE);
+  ls->file_len = size + 1;
+  ls->file_mapped = size % page != 0;
+  if (ls->file_mapped) {
+    ls->file_base = (char *) mmap(NULL, ls->file_len, PROT_READ,
+                                  MAP_PRIVATE, fd, 0);
+    if (ls->file_base == MAP_FAILED)
+      ls->file_mapped = false;
+  }
+  if (!ls->file_mapped) {
+    size_t n = 0;
+    ssize_t r;
+    ls->file_base = (char *) malloc(ls->file_len);
+    while (n < size && (r = read(fd, ls->file_base + n, size - n)) > 0)
+      n += r;
+    if (n < size) {
+      cerr << "read() in scanner failed\n";
+      exit(1);
+    }
+    ls->file_base[size] = '\0';
+  }
+
+  direct_scanner *s = scanner_of(ls);
+  free(s->owned);
+  s->owned = NULL;
+  s->cur = ls->file_base;
+  s->lim = ls->file_base + size;
+  s->active = true;
+  return true;
+}
+
+void cool_lex_unmap_file(cool_lex_state *ls)
+{
+  if (ls->file_mapped)
+    munmap(ls->file_base, ls->file_len);
+  else
+    free(ls->file_base);
+  ls->file_base = NULL;
+  scanner_of(ls)->active = false;
+}
+
+void cool_lex_set_text(cool_lex_state *ls, char *base, int size,
+                       int start, int comment_depth)
+{
+  direct_scanner *s = scanner_of(ls);
+  free(s->owned);
+  s->owned = NULL;
+  s->cur = base;
+  s->lim = base + size - 2;
+  s->active = true;
+  s->start = start;
+  ls->comment_depth = comment_depth;
+  reset_str(ls);
+}
+
+void cool_lex_end_text(cool_lex_state *ls)
+{
+  scanner_of(ls)->active = false;
+}
+
+//
+// The default scanner, as in cool.flex.
+//
+static cool_lex_state *default_lexer;
+
+static cool_lex_state *get_default_lexer()
+{
+  if (default_lexer == NULL)
+    default_lexer = cool_lex_new(fin);
+  return default_lexer;
+}
+
+int cool_yylex()
+{
+  cool_lex_state *ls = get_default_lexer();
+  ls->fin = fin;
+  ls->lineno = curr_lineno;
+
+  int token = cool_lex(ls);
+  curr_lineno = ls->lineno;
+  cool_yylval = ls->lval;
+  return token;
+}
+
+int cool_yylex_tokens(TokenBuffer &buf, int max)
+{
+  cool_lex_state *ls = get_default_lexer();
+  ls->fin = fin;
+  ls->lineno = curr_lineno;
+
+  int n = cool_lex_tokens(ls, buf, max);
+  curr_lineno = ls->lineno;
+  return n;
+}
+
+bool cool_yy_map_file(FILE *f)
+{
+  return cool_lex_map_file(get_default_lexer(), f);
+}
+
+void cool_yy_unmap_file()
+{
+  cool_lex_unmap_file(get_default_lexer());
+}
@@ -0,0 +1,395 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//  lexbench.cc
+//
+//  Measures the speed of the scanner.
+//
+//  Each input is scanned with cool_yylex several times, and the fastest
+//  run is reported in tokens and megabytes per second.  The inputs are
+//  the files named on the command line, followed by four synthetic
+//  corpora of a given size:
+//
+//      identifiers   declarations and expressions over many names
+//      literals      integer and string constants
+//      comments      license headers and -- comments around a little code
+//      nested        comments nested 64 deep
+//
+//  usage: lexbench [-m] [-t] [-i lines] [-c texts] [-n bytes] [-r runs] [files]
+//
+//  -m scans the inputs in memory (see cool_yy_map_file), -t lexes into a
+//  TokenBuffer with cool_yylex_tokens instead of calling cool_yylex for
+//  each token, -n sets the size of the synthetic corpora (default 4 MB)
+//  and -r the number of runs (default 5).  With -n 0 only the named files
+//  are scanned.
+//
+//  -i measures incremental lexing instead (see relex.cc): a file of the
+//  given number of lines is lexed with a cool_relex, then edited one line
+//  at a time, and the time taken by each edit is reported.
+//
+//  -c checks incremental lexing instead: the given number of random texts
+//  are each edited RELEX_CHECK_EDITS times, and after every edit the
+//  tokens of the cool_relex are compared with those of a full lex of the
+//  edited text.  The texts are made of pieces that end strings, comments
+//  and lines in awkward places, and put null characters in strings.  The
+//  exit status is 1 if any differ.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>     // for getopt
+#include <time.h>
+#include <string>
+#include "cool-parse.h"
+#include "cool-lex.h"
+#include "stringtab.h"
+
+int curr_lineno = 1;
+char *curr_filename = "<stdin>";
+FILE *fin;
+YYSTYPE cool_yylval;
+
+static int runs = 5;
+static long corpus_size = 4 * 1024 * 1024;
+static bool map_input = false;
+static bool batch = false;
+static int relex_lines = 0;
+static int relex_texts = 0;
+
+#define RELEX_EDITS 1000
+#define RELEX_CHECK_EDITS 20
+
+static double now()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//
+// Scan f to the end runs times and print the fastest run.
+//
+static void bench(const char *name, FILE *f)
+{
+  fseek(f, 0, SEEK_END);
+  long bytes = ftell(f);
+  long tokens = 0;
+  double best = 0;
+
+  for (int r = 0; r < runs; r++) {
+    rewind(f);
+    fin = f;
+    curr_lineno = 1;
+    double start = now();
+    bool mapped = map_input && cool_yy_map_file(f);
+    tokens = 0;
+    if (batch) {
+      TokenBuffer buf;
+      int n;
+      do {
+        n = cool_yylex_tokens(buf, 4096);
+        tokens += n;
+        buf.clear();
+      } while (n == 4096);
+    } else {
+      while (cool_yylex() != 0)
+        tokens++;
+    }
+    if (mapped)
+      cool_yy_unmap_file();
+    double t = now() - start;
+    if (r == 0 || t < best)
+      best = t;
+  }
+
+  if (best <= 0)
+    best = 1e-9;
+  printf("%-20s %10.1f %10ld %12.2f %10.1f\n", name, bytes / 1024.0,
+         tokens, tokens / best / 1e6, bytes / best / (1024.0 * 1024.0));
+}
+
+//
+// The synthetic corpora.  Each generator writes one chunk of text; the
+// chunk is repeated until the corpus has the requested size.  i numbers
+// the chunks, so that names and constants vary.
+//
+static void identifier_chunk(FILE *f, int i)
+{
+  fprintf(f, "class Node%d inherits Base%d {\n", i % 500, i % 7);
+  fprintf(f, "  child_%d : Node%d;\n", i % 1000, (i + 1) % 500);
+  fprintf(f, "  visit_%d(left_%d : Node%d, right_%d : Object) : Node%d {\n",
+          i % 300, i % 50, i % 500, i % 50, i % 500);
+  fprintf(f, "    let tmp_%d : Node%d <- left_%d.copy() in "
+          "if isvoid tmp_%d then self else tmp_%d@Base%d.visit_%d(child_%d, "
+          "right_%d) fi\n",
+          i % 20, i % 500, i % 50, i % 20, i % 20, i % 7, i % 300,
+          i % 1000, i % 50);
+  fprintf(f, "  };\n};\n");
+}
+
+static void literal_chunk(FILE *f, int i)
+{
+  fprintf(f, "x <- %d + %d * %d;\n", i, i * 7 % 100003, i % 97);
+  fprintf(f, "s <- \"message number %d: \\tall is \\\"well\\\"\\n\";\n", i);
+  fprintf(f, "t <- \"%d %d %d %d %d %d %d %d\";\n",
+          i, i + 1, i + 2, i + 3, i + 4, i + 5, i + 6, i + 7);
+  fprintf(f, "b <- true; c <- false; y <- %d;\n", i % 10);
+}
+
+static void comment_chunk(FILE *f, int i)
+{
+  fprintf(f,
+    "(*\n"
+    " *  Copyright (c) 1995-2012 The Regents of the University of\n"
+    " *  California.  All rights reserved.\n"
+    " *\n"
+    " *  Permission to use, copy, modify, and distribute this software for\n"
+    " *  any purpose, without fee, and without written agreement is hereby\n"
+    " *  granted, provided that the above copyright notice and the following\n"
+    " *  two paragraphs appear in all copies of this software.  (generated\n"
+    " *  file %d; do not edit)\n"
+    " *)\n"
+    "-- This class was generated; see the generator for documentation.\n"
+    "-- Changes made here will be lost.\n"
+    "class Generated%d { f() : Int { %d }; };\n", i, i, i);
+}
+
+static void nested_chunk(FILE *f, int i)
+{
+  const int depth = 64;
+  for (int d = 0; d < depth; d++)
+    fprintf(f, "(* level %d of comment %d\n", d, i);
+  for (int d = 0; d < depth; d++)
+    fprintf(f, "   end of level %d *)", depth - 1 - d);
+  fprintf(f, "\nx%d <- %d;\n", i, i);
+}
+
+static FILE *make_corpus(void (*chunk)(FILE *, int))
+{
+  FILE *f = tmpfile();
+  if (f == NULL) {
+    perror("lexbench: tmpfile");
+    exit(1);
+  }
+  for (int i = 0; ftell(f) < corpus_size; i++)
+    chunk(f, i);
+  fflush(f);
+  return f;
+}
+
+//
+// Make a file of nlines lines of identifier_chunk, then alternately
+// insert and delete a character in the middle of a random line.
+//
+static void bench_relex(int nlines)
+{
+  FILE *f = make_corpus(identifier_chunk);
+  rewind(f);
+  std::string text;
+  int lines = 0;
+  while (lines < nlines) {
+    char line[256];
+    if (fgets(line, sizeof(line), f) == NULL) {
+      rewind(f);
+      continue;
+    }
+    text += line;
+    lines++;
+  }
+  fclose(f);
+
+  cool_relex *r = cool_relex_new();
+  double start = now();
+  cool_relex_set_text(r, text.data(), text.size());
+  double full = now() - start;
+
+  double total = 0, worst = 0;
+  long scanned = 0;
+  srand(1);
+  for (int e = 0; e < RELEX_EDITS; e++) {
+    int line = rand() % r->lines.count;
+    int offset = r->lines.cps[line].offset + 4;
+    start = now();
+    if (e % 2 == 0)
+      scanned += cool_relex_edit(r, offset, 0, "x", 1);
+    else
+      scanned += cool_relex_edit(r, offset, 1, "", 0);
+    double t = now() - start;
+    total += t;
+    if (t > worst)
+      worst = t;
+  }
+
+  printf("%d lines, %d tokens: full lex %.3f ms\n", r->lines.count,
+         r->tokens.count, full * 1e3);
+  printf("%d one-line edits: %.3f ms average, %.3f ms worst, "
+         "%.1f lines scanned per edit\n", RELEX_EDITS,
+         total / RELEX_EDITS * 1e3, worst * 1e3,
+         (double) scanned / RELEX_EDITS);
+  cool_relex_delete(r);
+}
+
+//
+// The pieces that random texts for check_relex are made of.  Some hold
+// null characters, so their lengths are kept.
+//
+#define PIECE(s) std::string(s, sizeof(s) - 1)
+
+static const std::string relex_pieces[] = {
+  PIECE("class A inherits B { x : Int <- 1; };\n"),
+  PIECE("foo(bar) ~ 3 <= 4;\n"), PIECE("while true loop not False pool\n"),
+  PIECE("-- a comment\n"), PIECE("(* c *)\n"), PIECE("(*"), PIECE("*)"),
+  PIECE("\""), PIECE("\"ok\" "), PIECE("\"a\\\nb\"\n"), PIECE("\"abc\n"),
+  PIECE("\\"), PIECE("\\0"), PIECE("\"a\0b\" "), PIECE("\"a\\\0b\" "),
+  PIECE("\0"), PIECE("# $ ! ^\n"), PIECE("\n"), PIECE(" "), PIECE("x"),
+  PIECE("Y"), PIECE("12"),
+};
+
+#define NPIECES (int) (sizeof(relex_pieces) / sizeof(relex_pieces[0]))
+
+static bool same_tokens(TokenBuffer &a, TokenBuffer &b)
+{
+  if (a.count != b.count)
+    return false;
+  for (int i = 0; i < a.count; i++) {
+    if (a.kinds[i] != b.kinds[i] || a.lines[i] != b.lines[i])
+      return false;
+    switch (a.kinds[i]) {
+    case TYPEID:
+    case OBJECTID:
+    case INT_CONST:
+    case STR_CONST:
+      if (a.values[i].symbol != b.values[i].symbol)
+        return false;
+      break;
+    case BOOL_CONST:
+      if (a.values[i].boolean != b.values[i].boolean)
+        return false;
+      break;
+    case ERROR:
+      if (strcmp(a.values[i].error_msg, b.values[i].error_msg) != 0)
+        return false;
+      break;
+    }
+  }
+  return true;
+}
+
+//
+// Edit ntexts random texts at random, and compare the tokens after each
+// edit with those of a full lex.  Returns the number of edits after
+// which they differ.
+//
+static int check_relex(int ntexts)
+{
+  int bad = 0;
+  srand(1);
+  for (int t = 0; t < ntexts; t++) {
+    std::string text;
+    for (int n = rand() % 64; n > 0; n--)
+      text += relex_pieces[rand() % NPIECES];
+    cool_relex *r = cool_relex_new();
+    cool_relex_set_text(r, text.data(), text.size());
+
+    for (int e = 0; e < RELEX_CHECK_EDITS; e++) {
+      int offset = rand() % (text.size() + 1);
+      int old_len = rand() % 3 == 0 ? rand() % 8 : 0;
+      if (offset + old_len > (int) text.size())
+        old_len = text.size() - offset;
+      std::string piece = rand() % 3 ? relex_pieces[rand() % NPIECES] : "";
+      cool_relex_edit(r, offset, old_len, piece.data(), piece.size());
+      text.replace(offset, old_len, piece);
+
+      cool_relex *full = cool_relex_new();
+      cool_relex_set_text(full, text.data(), text.size());
+      if (!same_tokens(r->tokens, full->tokens)) {
+        if (bad == 0)
+          printf("text %d, edit %d: tokens differ from a full lex of\n%s\n",
+                 t, e, text.c_str());
+        bad++;
+      }
+      cool_relex_delete(full);
+    }
+    cool_relex_delete(r);
+  }
+  printf("%d texts, %d edits each: %d differ from a full lex\n",
+         ntexts, RELEX_CHECK_EDITS, bad);
+  return bad;
+}
+
+int main(int argc, char *argv[])
+{
+  int c;
+  while ((c = getopt(argc, argv, "mti:c:n:r:")) != -1) {
+    switch (c) {
+    case 'm':
+      map_input = true;
+      break;
+    case 't':
+      batch = true;
+      break;
+    case 'i':
+      relex_lines = atoi(optarg);
+      break;
+    case 'c':
+      relex_texts = atoi(optarg);
+      break;
+    case 'n':
+      corpus_size = atol(optarg);
+      break;
+    case 'r':
+      runs = atoi(optarg);
+      break;
+    default:
+      cerr << "usage: " << argv[0] << " [-m] [-t] [-i lines] [-c texts] [-n bytes] [-r runs] [files]\n";
+      exit(1);
+    }
+  }
+  if (runs < 1)
+    runs = 1;
+
+  if (relex_lines > 0) {
+    bench_relex(relex_lines);
+    exit(0);
+  }
+  if (relex_texts > 0)
+    exit(check_relex(relex_texts) ? 1 : 0);
+
+  printf("%-20s %10s %10s %12s %10s\n",
+         "input", "KB", "tokens", "Mtokens/s", "MB/s");
+
+  for (int i = optind; i < argc; i++) {
+    FILE *f = fopen(argv[i], "r");
+    if (f == NULL) {
+      cerr << "Could not open input file " << argv[i] << endl;
+      exit(1);
+    }
+    const char *name = strrchr(argv[i], '/');
+    bench(name ? name + 1 : argv[i], f);
+    fclose(f);
+  }
+
+  if (corpus_size > 0) {
+    static struct {
+      const char *name;
+      void (*chunk)(FILE *, int);
+    } corpora[] = {
+      { "identifiers", identifier_chunk },
+      { "literals",    literal_chunk },
+      { "comments",    comment_chunk },
+      { "nested",      nested_chunk },
+    };
+    for (unsigned i = 0; i < sizeof(corpora) / sizeof(corpora[0]); i++) {
+      FILE *f = make_corpus(corpora[i].chunk);
+      bench(corpora[i].name, f);
+      fclose(f);
+    }
+  }
+  exit(0);
+}
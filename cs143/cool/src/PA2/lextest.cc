@@ -12,11 +12,32 @@
 //
 //  Option -l prints summary of flex actions.
 //
+//  Option -m makes the lexer scan each input file in memory (see
+//  cool_yy_map_file in cool.flex) rather than read it through fin.
+//
+//  Option -b writes the tokens as a binary token stream (see
+//  tokenstream.h), which the parser reads when also given -b.
+//
+//  Option -j n lexes the input files on n threads.  The tokens are
+//  printed in the order of the files, exactly as without -j, and the
+//  time taken is reported on cerr.
+//
+//  Option -C dir keeps the tokens of each input file in a cache in dir
+//  (see tokencache.h), and takes them from there rather than scanning a
+//  file whose text is already in the cache.  The number of files found
+//  in the cache and not is reported on cerr.
+//
 //////////////////////////////////////////////////////////////////////////////
 
 #include <stdio.h>      // needed on Linux system
 #include <unistd.h>     // for getopt
+#include <pthread.h>    // for -j
+#include <time.h>
 #include "cool-parse.h" // bison-generated file; defines tokens
+#include "cool-lex.h"   // the scanner interface
+#include "tokenstream.h"
+#include "tokencache.h"
+#include "stringtab.h"
 #include "utilities.h"
 
 //
@@ -28,10 +49,9 @@ char *curr_filename = "<stdin>"; // this name is arbitrary
 FILE *fin;   // This is the file pointer from which the lexer reads its input.
 
 //
-//  cool_yylex() is the function produced by flex. It returns the next
-//  token each time it is called.
+//  cool_yylex() (see cool-lex.h) returns the next token each time it is
+//  called.
 //
-extern int cool_yylex();
 YYSTYPE cool_yylval;           // Not compiled with parser, so must define this.
 
 extern int optind;  // used for option processing (man 3 getopt for more info)
@@ -42,6 +62,10 @@ extern int optind;  // used for option processing (man 3 getopt for more info)
 //
 extern int yy_flex_debug;      // Flex debugging; see flex documentation.
 extern int lex_verbose;        // Controls printing of tokens.
+extern int lex_mmap;           // Scan input files in memory.
+extern int lex_jobs;           // Lex input files on this many threads.
+extern int token_binary;       // Write a binary token stream.
+extern char *token_cache_dir;  // Cache tokens in this directory.
 void handle_flags(int argc, char *argv[]);
 
 //
@@ -52,15 +76,153 @@ void handle_flags(int argc, char *argv[]);
 //
 int  cool_yydebug;
 
-// defined in utilities.cc
-extern void dump_cool_token(ostream& out, int lineno, 
-			    int token, YYSTYPE yylval);
+//
+//  Tokens are lexed into a TokenBuffer TOKEN_CHUNK at a time.  For the
+//  binary format, which needs all the tokens of a file at once, the
+//  chunks are collected until the end of the file.
+//
+#define TOKEN_CHUNK 4096
+
+static TokenCache *token_cache;  // with -C
+
+//
+//  Parallel lexing (option -j).
+//
+//  Each input file is a job.  The threads take jobs in turn until none
+//  are left, and scan each file with a scanner of their own into the
+//  job's token buffer.  The string tables are shared by the threads (see
+//  StringTable::make_shared).  Once all files are lexed the tokens are
+//  written to cout in the order of the files.
+//
+struct lex_job {
+    char *filename;
+    bool opened;           // false if the file could not be opened
+    double seconds;        // time taken to lex the file
+    TokenBuffer tokens;    // the tokens of the file
+};
+
+static lex_job *jobs;
+static int njobs;
+static int next_job;       // the first job not yet taken
+static pthread_mutex_t next_job_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void lex_file(lex_job *job)
+{
+    double start = now();
+    FILE *f = fopen(job->filename, "r");
+    job->opened = (f != NULL);
+    if (f == NULL)
+	return;
+
+    cache_key key;
+    if (token_cache && token_cache->lookup(f, job->tokens, &key)) {
+	fclose(f);
+	job->seconds = now() - start;
+	return;
+    }
+
+    cool_lex_state *ls = cool_lex_new(f);
+    if (lex_mmap)
+	cool_lex_map_file(ls, f);
+
+    while (cool_lex_tokens(ls, job->tokens, TOKEN_CHUNK) == TOKEN_CHUNK)
+	;
+
+    cool_lex_delete(ls);
+    fclose(f);
+    if (token_cache)
+	token_cache->store(key, job->tokens);
+    job->seconds = now() - start;
+}
+
+static void *lex_worker(void *)
+{
+    for (;;) {
+	pthread_mutex_lock(&next_job_lock);
+	int i = next_job++;
+	pthread_mutex_unlock(&next_job_lock);
+	if (i >= njobs)
+	    return NULL;
+	lex_file(&jobs[i]);
+    }
+}
+
+//
+//  Lex files[0..nfiles-1] on lex_jobs threads and print their tokens.
+//  The speedup reported is the time the files took to lex, added up,
+//  over the time taken to lex them all; run with -j 1 for the time of a
+//  sequential run.
+//
+static void lex_parallel(int nfiles, char **files)
+{
+    idtable.make_shared();
+    inttable.make_shared();
+    stringtable.make_shared();
+
+    njobs = nfiles;
+    jobs = new lex_job[njobs];
+    for (int i = 0; i < njobs; i++) {
+	jobs[i].filename = files[i];
+	jobs[i].opened = false;
+	jobs[i].seconds = 0;
+    }
+
+    int nthreads = (lex_jobs < njobs) ? lex_jobs : njobs;
+    pthread_t *threads = new pthread_t[nthreads];
+    double start = now();
+    for (int i = 0; i < nthreads; i++)
+	if (pthread_create(&threads[i], NULL, lex_worker, NULL) != 0) {
+	    cerr << "Could not create lexer thread" << endl;
+	    exit(1);
+	}
+    for (int i = 0; i < nthreads; i++)
+	pthread_join(threads[i], NULL);
+    double wall = now() - start;
+    delete [] threads;
+
+    double busy = 0;
+    for (int i = 0; i < njobs; i++) {
+	if (!jobs[i].opened) {
+	    cerr << "Could not open input file " << jobs[i].filename << endl;
+	    exit(1);
+	}
+	if (token_binary)
+	    write_binary_file(cout, jobs[i].filename, jobs[i].tokens);
+	else {
+	    cout << "#name \"" << jobs[i].filename << "\"" << endl;
+	    dump_cool_tokens(cout, jobs[i].tokens);
+	}
+	busy += jobs[i].seconds;
+    }
+    cout.flush();
+
+    cerr << "lexed " << njobs << " files on " << nthreads << " threads in "
+	 << wall * 1e3 << " ms (" << busy * 1e3 << " ms of lexing), speedup "
+	 << (wall > 0 ? busy / wall : 1.0) << endl;
+    delete [] jobs;
+}
 
 
 int main(int argc, char** argv) {
-	int token;
+	TokenBuffer tokens;
 	
 	handle_flags(argc,argv);
+	if (token_cache_dir)
+	    token_cache = new TokenCache(token_cache_dir);
+
+	if (lex_jobs > 0 && optind < argc) {
+	    lex_parallel(argc - optind, argv + optind);
+	    if (token_cache)
+		token_cache->print_stats(cerr);
+	    exit(0);
+	}
 
 	while (optind < argc) {
 	    fin = fopen(argv[optind], "r");
@@ -74,16 +236,51 @@ int main(int argc, char** argv) {
             // do the same thing
             curr_lineno = 1;
 
+	    //
+	    // With -C, look the file up in the cache first.
+	    //
+	    tokens.clear();
+	    cache_key key;
+	    bool cached = token_cache && token_cache->lookup(fin, tokens, &key);
+
+	    //
+	    // With -m, scan the whole file in place.  Files that cannot be
+	    // mapped (pipes, terminals) are read through fin as usual.
+	    //
+	    bool mapped = !cached && lex_mmap && cool_yy_map_file(fin);
+
 	    //
 	    // Scan and print all tokens.
 	    //
-	    cout << "#name \"" << argv[optind] << "\"" << endl;
-	    while ((token = cool_yylex()) != 0) {
-		dump_cool_token(cout, curr_lineno, token, cool_yylval);
+	    if (token_binary || token_cache) {
+		if (!cached) {
+		    while (cool_yylex_tokens(tokens, TOKEN_CHUNK) == TOKEN_CHUNK)
+			;
+		    if (token_cache)
+			token_cache->store(key, tokens);
+		}
+		if (token_binary)
+		    write_binary_file(cout, argv[optind], tokens);
+		else {
+		    cout << "#name \"" << argv[optind] << "\"" << endl;
+		    dump_cool_tokens(cout, tokens);
+		}
+	    } else {
+		cout << "#name \"" << argv[optind] << "\"" << endl;
+		int n;
+		do {
+		    n = cool_yylex_tokens(tokens, TOKEN_CHUNK);
+		    dump_cool_tokens(cout, tokens);
+		    tokens.clear();
+		} while (n == TOKEN_CHUNK);
 	    }
+	    if (mapped)
+		cool_yy_unmap_file();
 	    fclose(fin);
 	    optind++;
 	}
+	if (token_cache)
+	    token_cache->print_stats(cerr);
 	exit(0);
 }
 
@@ -0,0 +1,283 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//  relex.cc
+//
+//  Incremental lexing.
+//
+//  While a cool_relex scans its text, the scanner records a checkpoint
+//  at every line start: the offset of the line, the number of tokens
+//  before it, and the start condition, comment depth and string length
+//  of the scanner there.  Tokens never span a line start except inside
+//  strings, so the scanner can be started again at the start of a line
+//  with the state in its checkpoint, and gives the same tokens from
+//  there on as the original scan did.
+//
+//  After an edit, scanning starts again at the last line start before
+//  the edit that can be resumed.  Once past the edit, the checkpoint of
+//  each new line start is compared with the checkpoint of the same line
+//  start in the old text; when the two match, the rest of the old tokens
+//  and checkpoints are kept, moved by the number of tokens, lines and
+//  bytes the edit added or removed.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cool-lex.h"
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Checkpoints
+//
+//////////////////////////////////////////////////////////////////////
+
+static void checkpoints_reserve(cool_checkpoints *c, int n)
+{
+  if (n <= c->size)
+    return;
+  int size = c->size ? c->size : 256;
+  while (size < n)
+    size *= 2;
+  cool_lex_checkpoint *cps = new cool_lex_checkpoint[size];
+  if (c->count)
+    memcpy(cps, c->cps, c->count * sizeof(cool_lex_checkpoint));
+  delete [] c->cps;
+  c->cps = cps;
+  c->size = size;
+}
+
+static void add_checkpoint(cool_lex_state *ls, int offset, int start)
+{
+  cool_checkpoints *c = ls->checkpoints;
+  if (c->count == c->size)
+    checkpoints_reserve(c, c->count + 1);
+  cool_lex_checkpoint *cp = &c->cps[c->count++];
+  cp->offset = offset;
+  cp->token = ls->ntokens;
+  cp->start = start;
+  cp->comment_depth = ls->comment_depth;
+  cp->string_length = ls->string_length;
+}
+
+//
+// text and len are the text about to be matched.  If it begins a line,
+// the line start is recorded with the current state; so is every line
+// start inside the text, which can only be in whitespace or the text of
+// a comment, where the state does not change.  A newline that ends the
+// text begins a line that is recorded with the next match, after the
+// action has run.
+//
+void cool_lex_note_lines(cool_lex_state *ls, int start,
+                         const char *text, int len)
+{
+  int offset = text - ls->text_base;
+  if (offset == 0 || text[-1] == '\n')
+    add_checkpoint(ls, offset, start);
+
+  const char *p = text;
+  const char *end = text + len - 1;
+  while (p < end && (p = (const char *) memchr(p, '\n', end - p)) != NULL) {
+    p++;
+    add_checkpoint(ls, p - ls->text_base, start);
+  }
+}
+
+static bool same_state(cool_lex_checkpoint *a, cool_lex_checkpoint *b)
+{
+  return a->start == b->start && a->comment_depth == b->comment_depth &&
+         a->string_length == b->string_length;
+}
+
+static int count_lines(const char *s, int n)
+{
+  const char *end = s + n;
+  int lines = 0;
+  while ((s = (const char *) memchr(s, '\n', end - s)) != NULL) {
+    lines++;
+    s++;
+  }
+  return lines;
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  cool_relex
+//
+//////////////////////////////////////////////////////////////////////
+
+cool_relex *cool_relex_new()
+{
+  cool_relex *r = new cool_relex;
+  r->ls = cool_lex_new(NULL);
+  r->size = 1024;
+  r->text = (char *) malloc(r->size);
+  r->len = 0;
+  r->text[0] = r->text[1] = '\0';
+  r->lines.cps = NULL;
+  r->lines.count = r->lines.size = 0;
+  return r;
+}
+
+void cool_relex_delete(cool_relex *r)
+{
+  cool_lex_delete(r->ls);
+  free(r->text);
+  delete [] r->lines.cps;
+  delete r;
+}
+
+int cool_relex_set_text(cool_relex *r, const char *text, int len)
+{
+  return cool_relex_edit(r, 0, r->len, text, len);
+}
+
+int cool_relex_edit(cool_relex *r, int offset, int old_len,
+                    const char *text, int len)
+{
+  assert(0 <= offset && 0 <= old_len && offset + old_len <= r->len);
+  int dbytes = len - old_len;
+  int dlines = count_lines(text, len) - count_lines(r->text + offset, old_len);
+
+  //
+  // Edit the text.
+  //
+  if (r->len + dbytes + 2 > r->size) {
+    while (r->len + dbytes + 2 > r->size)
+      r->size *= 2;
+    r->text = (char *) realloc(r->text, r->size);
+  }
+  memmove(r->text + offset + len, r->text + offset + old_len,
+          r->len - offset - old_len + 2);
+  memcpy(r->text + offset, text, len);
+  r->len += dbytes;
+
+  //
+  // Find the line to start at: the last one that starts at or before
+  // offset, or an earlier one if that is inside a string.
+  //
+  cool_checkpoints &old = r->lines;
+  int lo = 0, hi = old.count;        // old.cps[lo..hi) may start later
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (old.cps[mid].offset <= offset)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  int first = lo - 1;
+  while (first >= 0 && old.cps[first].string_length != 0)
+    first--;
+
+  cool_lex_checkpoint start = { 0, 0, 0, 0, 0 };
+  if (first >= 0)
+    start = old.cps[first];
+  else
+    first = 0;
+
+  //
+  // Scan from there until the state at a line start after the edit is
+  // the same as in the old text, or to the end.
+  //
+  cool_lex_state *ls = r->ls;
+  cool_checkpoints fresh = { NULL, 0, 0 };
+  TokenBuffer fresh_tokens;
+  ls->text_base = r->text;
+  ls->checkpoints = &fresh;
+  ls->ntokens = start.token;
+  ls->lineno = first + 1;
+  cool_lex_set_text(ls, r->text + start.offset, r->len - start.offset + 2,
+                    start.start, start.comment_depth);
+
+  int edit_end = offset + len;
+  int checked = 0;                   // fresh checkpoints compared so far
+  int resync = -1;                   // old checkpoint matched, if any
+  for (;;) {
+    int token = cool_lex(ls);
+    for (; checked < fresh.count; checked++) {
+      cool_lex_checkpoint *cp = &fresh.cps[checked];
+      int i = first + checked - dlines;   // the same line in the old text
+      if (cp->offset >= edit_end && 0 <= i && i < old.count &&
+          old.cps[i].offset == cp->offset - dbytes &&
+          cp->string_length == 0 && same_state(cp, &old.cps[i])) {
+        resync = i;
+        break;
+      }
+    }
+    if (resync >= 0 || token == 0)
+      break;
+    fresh_tokens.add(token, ls->lineno, ls->lval);
+    ls->ntokens++;
+  }
+  cool_lex_end_text(ls);
+  ls->checkpoints = NULL;
+
+  //
+  // Replace the old tokens and checkpoints from the start line on by the
+  // ones just scanned, up to the resynchronisation point, and move the
+  // rest of the old ones to match.
+  //
+  TokenBuffer &tokens = r->tokens;
+  int old_end = tokens.count;        // old tokens replaced: [start, old_end)
+  int new_end = ls->ntokens;
+  int lines_end = old.count;         // old lines replaced: [first, lines_end)
+  if (resync >= 0) {
+    old_end = old.cps[resync].token;
+    new_end = fresh.cps[checked].token;
+    lines_end = resync;
+  }
+  int nfresh = new_end - start.token;
+  int dtokens = new_end - old_end;
+  int tail = tokens.count - old_end;
+
+  tokens.free_messages(start.token, old_end);
+  tokens.reserve(tokens.count + dtokens);
+  if (dtokens != 0 && tail > 0) {
+    memmove(tokens.kinds + new_end, tokens.kinds + old_end,
+            tail * sizeof(short));
+    memmove(tokens.lines + new_end, tokens.lines + old_end,
+            tail * sizeof(int));
+    memmove(tokens.values + new_end, tokens.values + old_end,
+            tail * sizeof(YYSTYPE));
+  }
+  if (nfresh > 0) {
+    memcpy(tokens.kinds + start.token, fresh_tokens.kinds,
+           nfresh * sizeof(short));
+    memcpy(tokens.lines + start.token, fresh_tokens.lines,
+           nfresh * sizeof(int));
+    memcpy(tokens.values + start.token, fresh_tokens.values,
+           nfresh * sizeof(YYSTYPE));
+  }
+  // The error messages of the tokens copied now belong to tokens.
+  fresh_tokens.free_messages(nfresh, fresh_tokens.count);
+  fresh_tokens.release();
+  tokens.count += dtokens;
+  if (dlines != 0)
+    for (int i = new_end; i < tokens.count; i++)
+      tokens.lines[i] += dlines;
+
+  int nlines = resync >= 0 ? checked : fresh.count;
+  int dcount = first + nlines - lines_end;
+  int ltail = old.count - lines_end;
+  checkpoints_reserve(&old, old.count + dcount);
+  if (dcount != 0 && ltail > 0)
+    memmove(old.cps + first + nlines, old.cps + lines_end,
+            ltail * sizeof(cool_lex_checkpoint));
+  if (nlines > 0)
+    memcpy(old.cps + first, fresh.cps, nlines * sizeof(cool_lex_checkpoint));
+  old.count += dcount;
+  if (dbytes != 0 || dtokens != 0)
+    for (int i = first + nlines; i < old.count; i++) {
+      old.cps[i].offset += dbytes;
+      old.cps[i].token += dtokens;
+    }
+
+  delete [] fresh.cps;
+  return nlines;
+}
@@ -0,0 +1,77 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//  stringtab_bench.cc
+//
+//  Measures the cost of interning a string as the string table grows.
+//
+//  The table is filled with distinct identifiers in steps, doubling its
+//  size each time.  After each step the identifiers already in the table
+//  are interned again (as the lexer does for every repeated identifier),
+//  and the average time per add_string call is printed.  With the hashed
+//  string tables this time should stay roughly flat as the table grows.
+//
+//  usage: stringtab_bench [max-entries]
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cool-parse.h"
+#include "stringtab.h"
+
+YYSTYPE cool_yylval;           // utilities.cc refers to this
+
+#define LOOKUPS 1000000        // add_string calls timed at each table size
+
+//
+// Build the name of the i'th identifier.  The names have a common prefix,
+// as machine-generated identifiers usually do.
+//
+static void make_name(char *buf, int i)
+{
+  sprintf(buf, "generated_identifier_%d", i);
+}
+
+int main(int argc, char *argv[])
+{
+  int max_entries = (argc > 1) ? atoi(argv[1]) : 256000;
+  char buf[64];
+  int entries = 0;
+
+  printf("%10s %14s\n", "entries", "ns/add_string");
+  for (int size = 1000; size <= max_entries; size *= 2) {
+    for (; entries < size; entries++) {
+      make_name(buf, entries);
+      idtable.add_string(buf);
+    }
+
+    // Preformat the names so that only add_string is timed.
+    char **names = new char *[size];
+    for (int i = 0; i < size; i++) {
+      make_name(buf, i);
+      names[i] = strdup(buf);
+    }
+
+    // Visit the names with a stride, so successive lookups do not touch
+    // neighbouring entries.
+    clock_t start = clock();
+    for (int i = 0, j = 0; i < LOOKUPS; i++, j = (j + 7919) % size)
+      idtable.add_string(names[j]);
+    clock_t stop = clock();
+
+    double ns = 1e9 * (double) (stop - start) / CLOCKS_PER_SEC / LOOKUPS;
+    printf("%10d %14.1f\n", size, ns);
+
+    for (int i = 0; i < size; i++)
+      free(names[i]);
+    delete [] names;
+  }
+  exit(0);
+}
@@ -0,0 +1,361 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//  tokencache.cc
+//
+//  The on-disk token cache; see tokencache.h.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "tokencache.h"
+#include "stringtab.h"
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Hashing
+//
+//////////////////////////////////////////////////////////////////////
+
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME  0x100000001b3ULL
+
+static cache_key fnv(cache_key h, const char *s, size_t len)
+{
+  for (size_t i = 0; i < len; i++) {
+    h ^= (unsigned char) s[i];
+    h *= FNV_PRIME;
+  }
+  return h;
+}
+
+//
+// Read the whole of the regular file f into a malloc'ed buffer, and
+// leave f at its start.  Returns NULL if f is not a regular file.
+//
+static char *read_file(FILE *f, size_t *lenp)
+{
+  struct stat st;
+  if (fstat(fileno(f), &st) < 0 || !S_ISREG(st.st_mode))
+    return NULL;
+  size_t len = st.st_size;
+  char *text = (char *) malloc(len + 1);
+  rewind(f);
+  len = fread(text, 1, len, f);
+  rewind(f);
+  *lenp = len;
+  return text;
+}
+
+//
+// The stamp is a hash of the running executable.  If that cannot be
+// read, the time this file was compiled is used instead.
+//
+static cache_key make_stamp()
+{
+  cache_key h = FNV_OFFSET;
+  FILE *exe = fopen("/proc/self/exe", "r");
+  if (exe != NULL) {
+    size_t len;
+    char *text = read_file(exe, &len);
+    fclose(exe);
+    if (text != NULL) {
+      h = fnv(h, text, len);
+      free(text);
+      return h;
+    }
+  }
+  const char *built = __DATE__ " " __TIME__;
+  return fnv(h, built, strlen(built));
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Encoding
+//
+//  Numbers are written as in binary token streams, seven bits to a
+//  byte.  Reading checks every length and index, so that a damaged
+//  entry is a miss rather than a crash.
+//
+//////////////////////////////////////////////////////////////////////
+
+static void put_uint(std::string &buf, unsigned long long n)
+{
+  while (n >= 0x80) {
+    buf += (char) (n | 0x80);
+    n >>= 7;
+  }
+  buf += (char) n;
+}
+
+static void put_string(std::string &buf, const char *s, int len)
+{
+  put_uint(buf, len);
+  buf.append(s, len);
+}
+
+struct Reader {
+  const char *p, *end;
+  bool ok;
+
+  unsigned long long get_uint()
+  {
+    unsigned long long n = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (p == end)
+        break;
+      unsigned char c = *p++;
+      n |= (unsigned long long) (c & 0x7f) << shift;
+      if (!(c & 0x80))
+        return n;
+    }
+    ok = false;
+    return 0;
+  }
+
+  // The string is not NUL-terminated.
+  const char *get_string(int *lenp)
+  {
+    unsigned long long len = get_uint();
+    if (!ok || len > (unsigned long long) (end - p)) {
+      ok = false;
+      return NULL;
+    }
+    const char *s = p;
+    p += len;
+    *lenp = len;
+    return s;
+  }
+};
+
+//
+// The strings of one table used by the tokens of an entry, each with its
+// index in the entry.
+//
+struct LocalStrings {
+  std::vector<int> local;          // by table index; -1 if not used
+  std::vector<Symbol> syms;        // by index in the entry
+
+  int index_of(Symbol sym)
+  {
+    int i = sym->get_index();
+    if (i >= (int) local.size())
+      local.resize(i + 1, -1);
+    if (local[i] < 0) {
+      local[i] = syms.size();
+      syms.push_back(sym);
+    }
+    return local[i];
+  }
+
+  void put(std::string &buf)
+  {
+    put_uint(buf, syms.size());
+    for (size_t i = 0; i < syms.size(); i++)
+      put_string(buf, syms[i]->get_string(), syms[i]->get_len());
+  }
+};
+
+template <class Elem>
+static bool get_strings(Reader &in, StringTable<Elem> &tbl,
+                        std::vector<Symbol> &syms)
+{
+  unsigned long long count = in.get_uint();
+  if (!in.ok || count > (unsigned long long) (in.end - in.p))
+    return false;
+  syms.resize(count);
+  for (unsigned long long i = 0; i < count; i++) {
+    int len;
+    const char *s = in.get_string(&len);
+    if (!in.ok)
+      return false;
+    syms[i] = tbl.add_string((char *) s, len);
+  }
+  return true;
+}
+
+static bool get_symbol(Reader &in, std::vector<Symbol> &syms, Symbol *sym)
+{
+  unsigned long long i = in.get_uint();
+  if (!in.ok || i >= syms.size())
+    return false;
+  *sym = syms[i];
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  TokenCache
+//
+//////////////////////////////////////////////////////////////////////
+
+TokenCache::TokenCache(char *d) : dir(d), hits(0), misses(0)
+{
+  stamp = make_stamp();
+  if (mkdir(dir, 0777) < 0 && errno != EEXIST)
+    cerr << "token cache: cannot create " << dir << ": "
+         << strerror(errno) << endl;
+}
+
+char *TokenCache::entry_name(cache_key key, const char *suffix)
+{
+  char *name = new char[strlen(dir) + strlen(suffix) + 32];
+  sprintf(name, "%s/%016llx%s", dir, key, suffix);
+  return name;
+}
+
+bool TokenCache::lookup(FILE *f, TokenBuffer &tokens, cache_key *key)
+{
+  size_t text_len;
+  char *text = read_file(f, &text_len);
+  if (text == NULL) {
+    *key = 0;
+    return false;
+  }
+  *key = fnv(fnv(FNV_OFFSET, (char *) &stamp, sizeof(stamp)), text, text_len);
+  free(text);
+
+  char *name = entry_name(*key, ".tok");
+  FILE *entry = fopen(name, "r");
+  delete [] name;
+  size_t len;
+  char *buf = entry ? read_file(entry, &len) : NULL;
+  if (entry)
+    fclose(entry);
+
+  bool hit = false;
+  if (buf != NULL) {
+    Reader in = { buf, buf + len, true };
+    std::vector<Symbol> ids, ints, strings;
+    int start = tokens.count;
+
+    hit = len >= TOKEN_CACHE_MAGIC_LEN &&
+          memcmp(buf, TOKEN_CACHE_MAGIC, TOKEN_CACHE_MAGIC_LEN) == 0;
+    if (hit) {
+      in.p += TOKEN_CACHE_MAGIC_LEN;
+      hit = in.get_uint() == stamp && in.ok &&
+            get_strings(in, idtable, ids) &&
+            get_strings(in, inttable, ints) &&
+            get_strings(in, stringtable, strings);
+    }
+    unsigned long long n = hit ? in.get_uint() : 0;
+    hit = hit && in.ok;
+    std::string msg;
+    for (; hit && n > 0; n--) {
+      int token = in.get_uint();
+      int line = in.get_uint();
+      YYSTYPE value;
+      value.symbol = NULL;
+      switch (token) {
+      case TYPEID:
+      case OBJECTID:
+        hit = get_symbol(in, ids, &value.symbol);
+        break;
+      case INT_CONST:
+        hit = get_symbol(in, ints, &value.symbol);
+        break;
+      case STR_CONST:
+        hit = get_symbol(in, strings, &value.symbol);
+        break;
+      case BOOL_CONST:
+        value.boolean = in.get_uint() != 0;
+        break;
+      case ERROR: {
+        int msg_len;
+        const char *s = in.get_string(&msg_len);
+        if (in.ok) {
+          msg.assign(s, msg_len);                // add copies it
+          value.error_msg = (char *) msg.c_str();
+        }
+        break;
+      }
+      }
+      hit = hit && in.ok;
+      if (hit)
+        tokens.add(token, line, value);
+    }
+    hit = hit && in.p == in.end;
+    if (!hit)
+      tokens.count = start;
+    free(buf);
+  }
+
+  __sync_fetch_and_add(hit ? &hits : &misses, 1);
+  return hit;
+}
+
+void TokenCache::store(cache_key key, TokenBuffer &tokens)
+{
+  if (key == 0)
+    return;
+
+  LocalStrings ids, ints, strings;
+  std::string body;
+  put_uint(body, tokens.count);
+  for (int i = 0; i < tokens.count; i++) {
+    int token = tokens.kinds[i];
+    YYSTYPE &value = tokens.values[i];
+    put_uint(body, token);
+    put_uint(body, tokens.lines[i]);
+    switch (token) {
+    case TYPEID:
+    case OBJECTID:
+      put_uint(body, ids.index_of(value.symbol));
+      break;
+    case INT_CONST:
+      put_uint(body, ints.index_of(value.symbol));
+      break;
+    case STR_CONST:
+      put_uint(body, strings.index_of(value.symbol));
+      break;
+    case BOOL_CONST:
+      put_uint(body, value.boolean ? 1 : 0);
+      break;
+    case ERROR:
+      put_string(body, value.error_msg, strlen(value.error_msg));
+      break;
+    }
+  }
+
+  std::string buf(TOKEN_CACHE_MAGIC, TOKEN_CACHE_MAGIC_LEN);
+  put_uint(buf, stamp);
+  ids.put(buf);
+  ints.put(buf);
+  strings.put(buf);
+  buf += body;
+
+  // The entry is written under a name unique to this process and call.
+  static int serial;
+  char suffix[64];
+  sprintf(suffix, ".tmp.%d.%d", (int) getpid(),
+          __sync_fetch_and_add(&serial, 1));
+  char *tmp = entry_name(key, suffix);
+  char *name = entry_name(key, ".tok");
+  FILE *out = fopen(tmp, "w");
+  if (out != NULL) {
+    bool written = fwrite(buf.data(), 1, buf.size(), out) == buf.size();
+    if (fclose(out) == 0 && written)
+      rename(tmp, name);
+    else
+      unlink(tmp);
+  }
+  delete [] tmp;
+  delete [] name;
+}
+
+void TokenCache::print_stats(ostream &out)
+{
+  out << "token cache: " << hits << " hits, " << misses << " misses" << endl;
+}
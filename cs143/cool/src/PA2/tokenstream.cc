@@ -0,0 +1,393 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//  tokenstream.cc
+//
+//  Token buffers, and the writer and reader of binary token streams;
+//  the format is described in tokenstream.h.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <vector>
+#include "tokenstream.h"
+#include "stringtab.h"
+#include "utilities.h"
+
+extern int curr_lineno;
+extern char *curr_filename;
+
+// defined in utilities.cc
+extern void dump_cool_token(ostream& out, int lineno,
+			    int token, YYSTYPE yylval);
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Token buffers
+//
+//////////////////////////////////////////////////////////////////////
+
+void TokenBuffer::grow()
+{
+  int new_size = size ? 2 * size : 1024;
+  short *new_kinds = new short[new_size];
+  int *new_lines = new int[new_size];
+  YYSTYPE *new_values = new YYSTYPE[new_size];
+  if (count) {
+    memcpy(new_kinds, kinds, count * sizeof(short));
+    memcpy(new_lines, lines, count * sizeof(int));
+    memcpy(new_values, values, count * sizeof(YYSTYPE));
+  }
+  delete [] kinds;
+  delete [] lines;
+  delete [] values;
+  kinds = new_kinds;
+  lines = new_lines;
+  values = new_values;
+  size = new_size;
+}
+
+void TokenBuffer::reserve(int n)
+{
+  while (size < n)
+    grow();
+}
+
+void TokenBuffer::free_messages(int begin, int end)
+{
+  for (int i = begin; i < end; i++)
+    if (kinds[i] == ERROR)
+      free(values[i].error_msg);
+}
+
+TokenBuffer::~TokenBuffer()
+{
+  free_messages(0, count);
+  delete [] kinds;
+  delete [] lines;
+  delete [] values;
+}
+
+void dump_cool_tokens(ostream &out, TokenBuffer &buf)
+{
+  for (int i = 0; i < buf.count; i++)
+    dump_cool_token(out, buf.lines[i], buf.kinds[i], buf.values[i]);
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Writing
+//
+//////////////////////////////////////////////////////////////////////
+
+static void put_uint(std::string &buf, unsigned int n)
+{
+  while (n >= 0x80) {
+    buf += (char) (n | 0x80);
+    n >>= 7;
+  }
+  buf += (char) n;
+}
+
+static void put_string(std::string &buf, const char *s, int len)
+{
+  put_uint(buf, len);
+  buf.append(s, len);
+}
+
+//
+// The strings of a table sent so far: the stream index of each table
+// index, or -1 if the string has not been sent, and the symbols whose
+// strings are to be sent with the current record.
+//
+struct SentStrings {
+  std::vector<int> index;
+  int count;
+  std::vector<Symbol> fresh;
+};
+
+static SentStrings ids_sent, ints_sent, strings_sent;
+
+static SentStrings *sent_table(int token)
+{
+  switch (token) {
+  case TYPEID:
+  case OBJECTID:
+    return &ids_sent;
+  case INT_CONST:
+    return &ints_sent;
+  case STR_CONST:
+    return &strings_sent;
+  }
+  return NULL;
+}
+
+//
+// Give sym a stream index if its string has not been sent.
+//
+static void note_string(SentStrings &sent, Symbol sym)
+{
+  int i = sym->get_index();
+  if (i >= (int) sent.index.size())
+    sent.index.resize(2 * i + 64, -1);
+  if (sent.index[i] < 0) {
+    sent.index[i] = sent.count++;
+    sent.fresh.push_back(sym);
+  }
+}
+
+static void put_new_strings(std::string &buf, SentStrings &sent)
+{
+  put_uint(buf, sent.fresh.size());
+  for (size_t i = 0; i < sent.fresh.size(); i++)
+    put_string(buf, sent.fresh[i]->get_string(), sent.fresh[i]->get_len());
+  sent.fresh.clear();
+}
+
+static void put_token(std::string &buf, int token, int lineno,
+                      YYSTYPE &value)
+{
+  put_uint(buf, token);
+  put_uint(buf, lineno);
+  switch (token) {
+  case STR_CONST:
+  case INT_CONST:
+  case TYPEID:
+  case OBJECTID:
+    put_uint(buf, sent_table(token)->index[value.symbol->get_index()]);
+    break;
+  case BOOL_CONST:
+    put_uint(buf, value.boolean ? 1 : 0);
+    break;
+  case ERROR:
+    put_string(buf, value.error_msg, strlen(value.error_msg));
+    break;
+  }
+}
+
+static bool magic_sent = false;
+
+//
+// The strings of a record are those its tokens use first, in the order
+// they first use them, so the stream depends only on the tokens and not
+// on what else was interned meanwhile, as by other files lexed with -j.
+//
+void write_binary_file(ostream &out, char *name, TokenBuffer &tokens)
+{
+  for (int i = 0; i < tokens.count; i++) {
+    SentStrings *sent = sent_table(tokens.kinds[i]);
+    if (sent)
+      note_string(*sent, tokens.values[i].symbol);
+  }
+
+  std::string buf;
+  if (!magic_sent) {
+    buf.append(TOKEN_STREAM_MAGIC, TOKEN_STREAM_MAGIC_LEN);
+    magic_sent = true;
+  }
+  put_string(buf, name, strlen(name));
+  put_new_strings(buf, ids_sent);
+  put_new_strings(buf, ints_sent);
+  put_new_strings(buf, strings_sent);
+  put_uint(buf, tokens.count);
+  for (int i = 0; i < tokens.count; i++)
+    put_token(buf, tokens.kinds[i], tokens.lines[i], tokens.values[i]);
+
+  out.write(buf.data(), buf.size());
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Reading
+//
+//////////////////////////////////////////////////////////////////////
+
+static void bad_stream(const char *why)
+{
+  cerr << "binary token stream: " << why << endl;
+  exit(1);
+}
+
+//
+// A 32-bit number takes at most five bytes.
+//
+static unsigned int get_uint(FILE *in)
+{
+  unsigned int n = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    int c = getc(in);
+    if (c == EOF)
+      bad_stream("unexpected end of stream");
+    n |= (unsigned int) (c & 0x7f) << shift;
+    if (!(c & 0x80))
+      return n;
+  }
+  bad_stream("number too long");
+  return 0;
+}
+
+//
+// The bytes left in the stream, or INT_MAX if it is not a regular file.
+//
+static long bytes_left(FILE *in)
+{
+  struct stat st;
+  long pos = ftell(in);
+  if (pos < 0 || fstat(fileno(in), &st) < 0 || !S_ISREG(st.st_mode))
+    return INT_MAX;
+  return st.st_size - pos;
+}
+
+//
+// Read a length or count of things that each take at least one byte
+// of what follows, so it can be no more than the bytes left.
+//
+static int get_length(FILE *in)
+{
+  unsigned int n = get_uint(in);
+  if (n > (unsigned int) INT_MAX || (long) n > bytes_left(in))
+    bad_stream("length out of range");
+  return (int) n;
+}
+
+//
+// Read a string into a buffer that stays valid until the next call.
+//
+static char *get_string(FILE *in, int *lenp)
+{
+  static char *buf;
+  static size_t buf_size;
+
+  int len = get_length(in);
+  if ((size_t) len >= buf_size) {
+    free(buf);
+    buf_size = 2 * (size_t) len + 64;
+    buf = (char *) malloc(buf_size);
+    if (buf == NULL)
+      bad_stream("out of memory");
+  }
+  if ((int) fread(buf, 1, len, in) != len)
+    bad_stream("unexpected end of stream");
+  buf[len] = '\0';
+  *lenp = len;
+  return buf;
+}
+
+//
+// The symbols sent so far, for each table, by their index in the
+// stream.
+//
+struct SymbolMap {
+  Symbol *syms;
+  int count, size;
+};
+
+static SymbolMap id_map, int_map, string_map;
+
+template <class Elem>
+static void get_new_strings(FILE *in, StringTable<Elem> &tbl, SymbolMap &map)
+{
+  int count = get_length(in);
+  if (count > INT_MAX / 2 - 64 - map.count)
+    bad_stream("too many strings");
+  if (map.count + count > map.size) {
+    int size = 2 * (map.count + count) + 64;
+    Symbol *syms = new Symbol[size];
+    if (map.syms)
+      memcpy(syms, map.syms, map.count * sizeof(Symbol));
+    delete [] map.syms;
+    map.syms = syms;
+    map.size = size;
+  }
+  for (int i = 0; i < count; i++) {
+    int len;
+    char *s = get_string(in, &len);
+    map.syms[map.count++] = tbl.add_string(s, len);
+  }
+}
+
+static Symbol get_symbol(FILE *in, SymbolMap &map)
+{
+  unsigned int i = get_uint(in);
+  if (i >= (unsigned int) map.count)
+    bad_stream("symbol index out of range");
+  return map.syms[i];
+}
+
+static bool magic_read = false;
+
+bool read_binary_file(FILE *in, TokenBuffer &tokens, char **name)
+{
+  if (!magic_read) {
+    char magic[TOKEN_STREAM_MAGIC_LEN];
+    if (fread(magic, 1, TOKEN_STREAM_MAGIC_LEN, in) != TOKEN_STREAM_MAGIC_LEN
+        || memcmp(magic, TOKEN_STREAM_MAGIC, TOKEN_STREAM_MAGIC_LEN) != 0)
+      bad_stream("not a binary token stream");
+    magic_read = true;
+  }
+
+  int c = getc(in);
+  if (c == EOF)
+    return false;
+  ungetc(c, in);
+
+  int len;
+  *name = strdup(get_string(in, &len));
+  get_new_strings(in, idtable, id_map);
+  get_new_strings(in, inttable, int_map);
+  get_new_strings(in, stringtable, string_map);
+
+  for (int n = get_length(in); n > 0; n--) {
+    int token = get_uint(in);
+    int line = get_uint(in);
+    YYSTYPE value;
+    switch (token) {
+    case TYPEID:
+    case OBJECTID:
+      value.symbol = get_symbol(in, id_map);
+      break;
+    case INT_CONST:
+      value.symbol = get_symbol(in, int_map);
+      break;
+    case STR_CONST:
+      value.symbol = get_symbol(in, string_map);
+      break;
+    case BOOL_CONST:
+      value.boolean = get_uint(in) != 0;
+      break;
+    case ERROR:
+      value.error_msg = get_string(in, &len);
+      break;
+    default:
+      value.symbol = NULL;
+      break;
+    }
+    tokens.add(token, line, value);
+  }
+  return true;
+}
+
+static TokenBuffer file_tokens;  // the tokens of the current file
+static int next_token;           // the index of the next one
+
+int cool_binary_yylex(FILE *in)
+{
+  while (next_token == file_tokens.count) {
+    file_tokens.clear();
+    next_token = 0;
+    if (!read_binary_file(in, file_tokens, &curr_filename))
+      return 0;
+  }
+
+  curr_lineno = file_tokens.lines[next_token];
+  cool_yylval = file_tokens.values[next_token];
+  return file_tokens.kinds[next_token++];
+}
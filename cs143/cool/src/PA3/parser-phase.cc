@@ -10,6 +10,15 @@
 //
 //  Reads a COOL token stream from a file and builds the abstract syntax tree.
 //
+//  Built with -DPUSH_PARSER (make parser-push), the parser is a bison
+//  push parser, fed by the driver in parser-push.cc.  Built with
+//  -DPURE_PARSER (make parser-pure), it is a pure parser, run on each file
+//  of the token stream at once by the driver in parser-pure.cc.  Built
+//  with -DCHECK_PARSER (make parser-check), it only checks the syntax of
+//  the tokens: it builds no tree, and prints nothing but the errors.
+//  Built with -DRD_PARSER (make parser-rd), the parser is the hand-written
+//  one in parser-rd.cc rather than bison's.
+//
 //////////////////////////////////////////////////////////////////////////////
 
 #include <stdio.h>     // for Linux system
@@ -18,6 +27,7 @@
 #include "cool-tree.h"
 #include "utilities.h"  // for fatal_error
 #include "cool-parse.h"
+#include "tokenstream.h"
 
 //
 // These globals keep everything working.
@@ -30,18 +40,71 @@ extern Program ast_root;	 // the AST produced by the parse
 char *curr_filename = "<stdin>";
 
 extern int omerrs;             // a count of lex and parse errors
+extern int token_binary;       // the tokens are in binary (option -b)
 
 extern int cool_yyparse();
+extern int cool_push_parse();
+extern int cool_pure_parse();
+extern int cool_rd_parse();
 void handle_flags(int argc, char *argv[]);
 
+//
+// The parser reads tokens with cool_yylex, from the text format of
+// dump_cool_token (with the scanner in tokens-lex.cc) or with -b from a
+// binary token stream.
+//
+// The text scanner leaves the value, line and file name of each token
+// in variables of its own, so that it can run alongside the parser (see
+// parser-push.cc); cool_text_yylex copies them to the parser's.
+//
+extern int tokens_yylex();
+YYSTYPE tokens_lval;
+int tokens_lineno;
+char *tokens_filename = "<stdin>";
+
+#ifdef PURE_PARSER
+int curr_lineno;               // the pure parser has neither of these
+YYSTYPE cool_yylval;
+#else
+extern int curr_lineno;
+extern YYSTYPE cool_yylval;
+#endif
+
+int cool_text_yylex()
+{
+    int token = tokens_yylex();
+    cool_yylval = tokens_lval;
+    curr_lineno = tokens_lineno;
+    curr_filename = tokens_filename;
+    return token;
+}
+
+int cool_yylex()
+{
+    if (token_binary)
+	return cool_binary_yylex(token_file);
+    return cool_text_yylex();
+}
+
 int main(int argc, char *argv[]) {
     handle_flags(argc, argv);
+#if defined(PUSH_PARSER)
+    cool_push_parse();
+#elif defined(PURE_PARSER)
+    cool_pure_parse();
+#elif defined(RD_PARSER)
+    cool_rd_parse();
+#else
     cool_yyparse();
+#endif
     if (omerrs != 0) {
 	cerr << "Compilation halted due to lex and parse errors\n";
 	exit(1);
     }
+#ifndef CHECK_PARSER
     ast_root->dump_with_types(cout,0);
+#endif
+    release_nodes();
     return 0;
 }
 
@@ -0,0 +1,326 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//  parser-pure.cc
+//
+//  The driver of the pure parser (see parse-context.h).
+//
+//  The token stream is read whole, into a TokenBuffer for each of the
+//  files it holds: a record of a binary stream (-b), or the tokens
+//  following a #name line of a text one.  Each file is then parsed by a
+//  pure parser of its own, on up to -j threads (by default one for each
+//  file), and the classes of the files are put together, in the order of
+//  the files, into one program.
+//
+//  The error messages of each file are printed, in the order of the
+//  files, once all have been parsed.  As with the ordinary parser,
+//  parsing halts after the 51st error, counting those of all the files.
+//
+//  Files are parsed on their own, so a syntax error is not recovered from
+//  by reading into the next file, and a file without a class is an error,
+//  as it is when it is the only one.  Files without tokens are passed
+//  over, unless there are no others.
+//
+//  With -S the files are cut further, so that a single large one is
+//  parsed on several threads too.  A program is a list of classes, and
+//  a class starts with CLASS and holds no other: split_file scans the
+//  tokens of a file for the CLASS tokens outside all braces, and cuts it
+//  into ranges of whole classes, each of at least SPLIT_TOKENS tokens.
+//  The ranges are parsed apart and their classes put together in order.
+//  In a file that parses, every range parses, to the classes the file's
+//  parse would give them, with the same line numbers, as these are taken
+//  from the tokens.  In one that does not, a range may be cut where no
+//  class starts, and error recovery may read across a cut; so if any
+//  range of a file has errors, they are dropped, and the file is parsed
+//  again as a whole for the messages it has when parsed in one piece.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <sstream>
+#include <pthread.h>
+#include <unistd.h>
+#include "cool-io.h"
+#include "cool-parse.h"
+#include "cool-tree.h"
+#include "parse-context.h"
+#include "stringtab.h"
+#include "tokenstream.h"
+#include "utilities.h"
+
+extern FILE *token_file;
+extern char *curr_filename;
+extern int token_binary;
+extern int lex_jobs;
+extern int parse_split;
+
+extern Program ast_root;
+extern int omerrs;
+extern int node_lineno;
+
+// The text scanner (tokens-lex.cc), and the variables it sets.
+extern int tokens_yylex();
+extern YYSTYPE tokens_lval;
+extern int tokens_lineno;
+extern char *tokens_filename;
+
+int cool_yyparse(parse_context *parser);
+
+#define SPLIT_TOKENS 4096     // the least tokens in a range, with -S
+
+parse_context::parse_context(TokenBuffer *t, char *name, int begin, int end)
+  : tokens(t), next(begin), end(end < 0 ? t->count : end), last(-1),
+    filename(name), node_lineno(1), omerrs(0), stopped(false),
+    ast_root(NULL), parse_results(NULL)
+{ }
+
+//
+// Read the token stream, a context for each file with tokens.
+//
+static void read_files(std::vector<parse_context *> &files)
+{
+  TokenBuffer *tokens = new TokenBuffer();
+  char *filename = curr_filename;
+
+  if (token_binary) {
+    while (read_binary_file(token_file, *tokens, &filename))
+      if (tokens->count > 0) {
+	files.push_back(new parse_context(tokens, filename));
+	tokens = new TokenBuffer();
+      }
+  } else {
+    int token;
+    while ((token = tokens_yylex()) != 0) {
+      if (tokens_filename != filename && tokens->count > 0) {
+	files.push_back(new parse_context(tokens, filename));
+	tokens = new TokenBuffer();
+      }
+      filename = tokens_filename;
+      tokens->add(token, tokens_lineno, tokens_lval);
+    }
+    if (tokens->count > 0)
+      files.push_back(new parse_context(tokens, filename));
+    else
+      filename = tokens_filename;
+  }
+
+  // With no tokens at all, parse nothing, for the error.
+  if (files.empty())
+    files.push_back(new parse_context(tokens, filename));
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  The scanner and error routine of the pure parser
+//
+//////////////////////////////////////////////////////////////////////
+
+int cool_yylex(YYSTYPE *lval, int *lloc, parse_context *parser)
+{
+  TokenBuffer &tokens = *parser->tokens;
+  if (parser->stopped || parser->next == parser->end) {
+    parser->last = -1;
+    return 0;                   // at the end, the location is unchanged
+  }
+  int i = parser->next++;
+  *lval = tokens.values[i];
+  *lloc = tokens.lines[i];
+  parser->last = i;
+  return tokens.kinds[i];
+}
+
+void cool_yyerror(int *lloc, parse_context *parser, const char *s)
+{
+  if (parser->stopped)
+    return;
+
+  std::ostringstream msg;
+  msg << "\"" << parser->filename << "\", line " << *lloc << ": "
+      << s << " at or near ";
+  if (parser->last < 0) {
+    YYSTYPE none;
+    none.symbol = NULL;
+    print_cool_token(msg, 0, none);
+  } else
+    print_cool_token(msg, parser->tokens->kinds[parser->last],
+                     parser->tokens->values[parser->last]);
+  parser->messages.push_back(msg.str());
+
+  if (++parser->omerrs > 50)
+    parser->stopped = true;
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  The threads
+//
+//////////////////////////////////////////////////////////////////////
+
+static std::vector<parse_context *> files;
+static std::vector<parse_context *> *ranges;   // with -S, of each file
+
+static std::vector<parse_context *> jobs;     // what the threads parse
+static int next_job;                          // the next of them
+
+static void *parse_jobs(void *)
+{
+  for (;;) {
+    int i = __sync_fetch_and_add(&next_job, 1);
+    if (i >= (int) jobs.size())
+      return NULL;
+    parse_context *parser = jobs[i];
+    node_arena = &parser->arena;
+    node_line = &parser->node_lineno;
+    cool_yyparse(parser);
+  }
+}
+
+//
+// Parse the jobs, on a thread for each, or on -j threads.  With -S there
+// may be many more jobs than processors, and by default a thread is run
+// for each processor.
+//
+static void run_jobs()
+{
+  int nthreads = jobs.size();
+  int limit = lex_jobs;
+  if (limit <= 0 && parse_split)
+    limit = sysconf(_SC_NPROCESSORS_ONLN);
+  if (limit > 0 && limit < nthreads)
+    nthreads = limit;
+  next_job = 0;
+  pthread_t *threads = new pthread_t[nthreads];
+  for (int t = 0; t < nthreads; t++)
+    if (pthread_create(&threads[t], NULL, parse_jobs, NULL) != 0) {
+      cerr << "Could not create parser thread" << endl;
+      exit(1);
+    }
+  for (int t = 0; t < nthreads; t++)
+    pthread_join(threads[t], NULL);
+  delete [] threads;
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Splitting a file at its classes (-S)
+//
+//////////////////////////////////////////////////////////////////////
+
+//
+// Cut file into ranges, before CLASS tokens at brace depth 0.  Tokens
+// before the first class are kept with it.  A '}' too many counts for
+// nothing, so that the rest of the file may still be cut.
+//
+static void split_file(parse_context *file, std::vector<parse_context *> &out)
+{
+  TokenBuffer &tokens = *file->tokens;
+  int begin = file->next;
+  int depth = 0;
+
+  for (int i = begin; i < file->end; i++)
+    switch (tokens.kinds[i]) {
+    case '{':
+      depth++;
+      break;
+    case '}':
+      if (depth > 0)
+        depth--;
+      break;
+    case CLASS:
+      if (depth == 0 && i - begin >= SPLIT_TOKENS) {
+        out.push_back(new parse_context(&tokens, file->filename, begin, i));
+        begin = i;
+      }
+      break;
+    }
+  out.push_back(new parse_context(&tokens, file->filename, begin, file->end));
+}
+
+//
+// Parse the ranges of all the files, then again those files of which a
+// range has errors.  The files parsed whole are marked by their results.
+//
+static void parse_split_files()
+{
+  ranges = new std::vector<parse_context *>[files.size()];
+  for (size_t i = 0; i < files.size(); i++) {
+    split_file(files[i], ranges[i]);
+    jobs.insert(jobs.end(), ranges[i].begin(), ranges[i].end());
+  }
+  run_jobs();
+
+  jobs.clear();
+  for (size_t i = 0; i < files.size(); i++) {
+    std::vector<parse_context *> &r = ranges[i];
+    bool failed = false;
+    for (size_t k = 0; k < r.size(); k++)
+      failed = failed || r[k]->omerrs != 0;
+    if (failed)
+      jobs.push_back(files[i]);
+    else {
+      files[i]->ast_root = r[0]->ast_root;
+      Classes classes = nil_Classes();
+      for (size_t k = 0; k < r.size(); k++) {
+        Classes c = r[k]->parse_results;
+        for (Classes_class::iterator j = c->begin(); j != c->end(); ++j)
+          classes = extend(classes, *j);
+      }
+      files[i]->parse_results = classes;
+    }
+  }
+  if (!jobs.empty())
+    run_jobs();
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  The parse
+//
+//////////////////////////////////////////////////////////////////////
+
+//
+// Parse token_file.  Sets ast_root and omerrs, and returns 0 if the parse
+// succeeded, as cool_yyparse.
+//
+int cool_pure_parse()
+{
+  read_files(files);
+
+  idtable.make_shared();
+  inttable.make_shared();
+  stringtable.make_shared();
+
+  if (parse_split)
+    parse_split_files();
+  else {
+    jobs = files;
+    run_jobs();
+  }
+
+  omerrs = 0;
+  for (size_t i = 0; i < files.size(); i++)
+    for (size_t m = 0; m < files[i]->messages.size(); m++) {
+      cerr << files[i]->messages[m] << endl;
+      if (++omerrs > 50) {
+	fprintf(stdout, "More than 50 errors\n");
+	exit(1);
+      }
+    }
+  if (omerrs != 0)
+    return 1;
+
+  Classes classes = nil_Classes();
+  for (size_t i = 0; i < files.size(); i++) {
+    Classes c = files[i]->parse_results;
+    for (Classes_class::iterator k = c->begin(); k != c->end(); ++k)
+      classes = extend(classes, *k);
+  }
+  node_lineno = files[0]->ast_root->get_line_number();
+  ast_root = program(classes);
+  return 0;
+}
@@ -0,0 +1,250 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//  parser-push.cc
+//
+//  The driver of the push parser.
+//
+//  "make parser-push" builds cool.y as a bison push parser
+//  (api.push-pull), which is handed tokens one at a time rather than
+//  calling cool_yylex for them.  Here the tokens are read from
+//  token_file, in the text or the binary format (-b), by a reader thread,
+//  and passed to the parser thread in TokenBuffers of up to CHUNK_TOKENS
+//  tokens; a binary stream is passed a file record at a time.  Reading
+//  and decoding the tokens then runs alongside parsing, and the parser
+//  starts on the first tokens of a pipe while the lexer is still
+//  writing the rest.
+//
+//  The parser is impure: each token is pushed by setting cool_yychar,
+//  cool_yylval and curr_lineno (the parser's location) and calling
+//  cool_yypush_parse.  The reader thread therefore never touches these;
+//  the text scanner leaves its results in variables of its own (see
+//  parser-phase.cc), and binary records are decoded straight into a
+//  TokenBuffer.  Both intern strings into the shared string tables,
+//  which are made safe for that with StringTable::make_shared.
+//
+//  Each buffer holds the tokens of a single file, so that curr_filename
+//  can be set for the parser's actions and messages before its tokens are
+//  pushed.  Tokens, line numbers, file names and so the tree and the
+//  error messages are the same as with the pull parser.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "cool-io.h"
+#include "cool-parse.h"
+#include "stringtab.h"
+#include "tokenstream.h"
+
+// The push interface of the bison parser, from the header bison writes
+// for cool-push.cc; locations are line numbers, as in cool.y.
+#define YYLTYPE int
+#define cool_yylloc curr_lineno
+#include "cool-push.h"
+
+extern FILE *token_file;
+extern char *curr_filename;
+extern int curr_lineno;
+extern YYSTYPE cool_yylval;
+extern int token_binary;
+
+// The text scanner (tokens-lex.cc), and the variables it sets.
+extern int tokens_yylex();
+extern YYSTYPE tokens_lval;
+extern int tokens_lineno;
+extern char *tokens_filename;
+
+// The token pushed; an impure push parser keeps it in a global.
+extern int cool_yychar;
+
+#define CHUNK_TOKENS 1024     // tokens per buffer in the text format
+#define NCHUNKS 4             // buffers between the threads
+
+struct token_chunk {
+  TokenBuffer tokens;
+  char *filename;             // the file the tokens are from
+  bool end;                   // the last chunk of the stream
+};
+
+//
+// The chunks form a ring.  The reader fills chunk[filled % NCHUNKS] once
+// the parser has emptied it; the parser empties chunk[emptied % NCHUNKS]
+// once the reader has filled it.
+//
+static token_chunk chunks[NCHUNKS];
+static int filled, emptied;
+static bool stop;             // the parser is done; the reader may stop
+static pthread_t reader_thread;
+static bool reader_running;
+static pthread_mutex_t ring_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t ring_changed = PTHREAD_COND_INITIALIZER;
+
+//
+// Wait for a chunk to fill, or return NULL if the parser has stopped.
+//
+static token_chunk *free_chunk()
+{
+  pthread_mutex_lock(&ring_lock);
+  while (!stop && filled - emptied == NCHUNKS)
+    pthread_cond_wait(&ring_changed, &ring_lock);
+  token_chunk *c = stop ? NULL : &chunks[filled % NCHUNKS];
+  pthread_mutex_unlock(&ring_lock);
+  return c;
+}
+
+static void chunk_filled()
+{
+  pthread_mutex_lock(&ring_lock);
+  filled++;
+  pthread_cond_broadcast(&ring_changed);
+  pthread_mutex_unlock(&ring_lock);
+}
+
+static token_chunk *full_chunk()
+{
+  pthread_mutex_lock(&ring_lock);
+  while (filled == emptied)
+    pthread_cond_wait(&ring_changed, &ring_lock);
+  token_chunk *c = &chunks[emptied % NCHUNKS];
+  pthread_mutex_unlock(&ring_lock);
+  return c;
+}
+
+static void chunk_emptied()
+{
+  pthread_mutex_lock(&ring_lock);
+  emptied++;
+  pthread_cond_broadcast(&ring_changed);
+  pthread_mutex_unlock(&ring_lock);
+}
+
+//
+// The reader thread.  In the text format a token whose file differs from
+// that of the chunk being filled is held over for the next chunk.
+//
+static void *reader(void *)
+{
+  bool held = false;          // a token is held over
+  int token = 0;
+  char *filename = NULL;
+
+  for (;;) {
+    token_chunk *c = free_chunk();
+    if (c == NULL)
+      return NULL;
+    c->tokens.clear();
+    c->filename = NULL;
+
+    if (token_binary)
+      c->end = !read_binary_file(token_file, c->tokens, &c->filename);
+    else {
+      for (;;) {
+        if (!held) {
+          token = tokens_yylex();
+          filename = tokens_filename;
+          held = true;
+        }
+        if (c->tokens.count == 0)
+          c->filename = filename;
+        else if (filename != c->filename)
+          break;
+        if (token == 0)
+          break;
+        c->tokens.add(token, tokens_lineno, tokens_lval);
+        held = false;
+        if (c->tokens.count == CHUNK_TOKENS)
+          break;
+      }
+      c->end = held && token == 0 && filename == c->filename;
+    }
+
+    bool end = c->end;
+    chunk_filled();
+    if (end)
+      return NULL;
+  }
+}
+
+//
+// Push one token.
+//
+static int push_token(cool_yypstate *ps, int token, int lineno,
+                      YYSTYPE &value)
+{
+  cool_yychar = token;
+  cool_yylval = value;
+  curr_lineno = lineno;
+  return cool_yypush_parse(ps);
+}
+
+//
+// Push the tokens of buf while the parser asks for more.  Returns the
+// parser's status.
+//
+static int push_tokens(cool_yypstate *ps, TokenBuffer &buf)
+{
+  int status = YYPUSH_MORE;
+  for (int i = 0; i < buf.count && status == YYPUSH_MORE; i++)
+    status = push_token(ps, buf.kinds[i], buf.lines[i], buf.values[i]);
+  return status;
+}
+
+//
+// Stop the reader thread and wait for it.  This is also run at exit, as
+// yyerror exits after too many errors while the reader may still be
+// interning strings into the tables that exit is about to destroy.  The
+// reader stops once it has filled the chunk it is on.
+//
+static void stop_reader()
+{
+  if (!reader_running)
+    return;
+  pthread_mutex_lock(&ring_lock);
+  stop = true;
+  pthread_cond_broadcast(&ring_changed);
+  pthread_mutex_unlock(&ring_lock);
+  pthread_join(reader_thread, NULL);
+  reader_running = false;
+}
+
+//
+// Parse token_file.  Returns 0 if the parse succeeded, as cool_yyparse.
+//
+int cool_push_parse()
+{
+  idtable.make_shared();
+  inttable.make_shared();
+  stringtable.make_shared();
+
+  if (pthread_create(&reader_thread, NULL, reader, NULL) != 0) {
+    cerr << "Could not create token reader thread" << endl;
+    exit(1);
+  }
+  reader_running = true;
+  atexit(stop_reader);
+
+  cool_yypstate *ps = cool_yypstate_new();
+  int status = YYPUSH_MORE;
+  while (status == YYPUSH_MORE) {
+    token_chunk *c = full_chunk();
+    if (c->filename)
+      curr_filename = c->filename;
+    status = push_tokens(ps, c->tokens);
+    if (status == YYPUSH_MORE && c->end) {
+      YYSTYPE none;
+      none.symbol = NULL;
+      status = push_token(ps, 0, curr_lineno, none);
+    }
+    chunk_emptied();
+  }
+  cool_yypstate_delete(ps);
+  stop_reader();
+  return status;
+}
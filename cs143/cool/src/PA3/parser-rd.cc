@@ -0,0 +1,675 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//  parser-rd.cc
+//
+//  A hand-written parser for the grammar of cool.y (make parser-rd).
+//
+//  Declarations are parsed by recursive descent, and expressions by
+//  precedence climbing over the operator table of cool.y: a prefix
+//  operator's operand takes in the operators that bind tighter than it,
+//  and so does the right operand of a binary one.  The bodies of lets
+//  take in every operator, as bison resolves their conflicts by shifting.
+//  Each phrase has as its location the line of its first token, and each
+//  node is made with node_lineno set as YYLLOC_DEFAULT sets it for the
+//  rule that makes it, so the tree is the one bison's parser builds.
+//
+//  The tokens are read with cool_yylex, a token of lookahead at a time
+//  and only when needed, as bison reads them; so curr_filename and
+//  curr_lineno are the same when each node is made and each error is
+//  reported.  Errors are reported with cool.y's yyerror.
+//
+//  Errors are recovered from as bison recovers from them with the error
+//  rules of cool.y.  The functions of the states that shift error (those
+//  after CLASS, after the '{' of a class, after the '{' of a block, and
+//  where a let_expr starts) are the points of recovery.  An error sets
+//  failed, and is passed up to the innermost of them, which discards
+//  tokens up to one that may follow its error and goes on from there.
+//  Like bison's, an error is reported only if three tokens have been
+//  read since the last recovery, and one at the top level ends the parse.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include "cool-io.h"
+#include "cool-parse.h"
+#include "cool-tree.h"
+#include "stringtab.h"
+#include "utilities.h"
+
+extern int cool_yylex();
+extern YYSTYPE cool_yylval;
+extern int curr_lineno;
+extern char *curr_filename;
+
+// From cool.y: its error routine, the token it reports, and its results.
+extern void cool_yyerror(char *s);
+extern int cool_yychar;
+extern Program ast_root;
+extern Classes parse_results;
+extern int node_lineno;
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Tokens and errors
+//
+//////////////////////////////////////////////////////////////////////
+
+#define NO_TOKEN (-2)           // no lookahead has been read
+
+static int token;               // the lookahead
+static int token_line;          // its line
+static YYSTYPE token_value;     // and its value
+
+static bool failed;             // an error is being passed up
+static bool aborted;            // the parse has been given up
+static int errstatus;           // as bison's yyerrstatus: the tokens to be
+                                // read before another error is reported
+
+static int peek()
+{
+  if (token == NO_TOKEN) {
+    token = cool_yylex();
+    token_line = curr_lineno;
+    token_value = cool_yylval;
+  }
+  return token;
+}
+
+// Read the lookahead past.  Returns its line.
+static int shift()
+{
+  peek();
+  token = NO_TOKEN;
+  if (errstatus > 0)
+    errstatus--;
+  return token_line;
+}
+
+//
+// The lookahead cannot follow what has been read.  Report it, unless an
+// error has been recovered from just before, and set failed.
+//
+static void syntax_error()
+{
+  peek();
+  if (errstatus == 0) {
+    cool_yychar = token;
+    cool_yyerror("syntax error");
+  }
+  if (errstatus == 3) {
+    // No token has been read since the last recovery: discard this one.
+    if (token == 0)
+      aborted = true;
+    token = NO_TOKEN;
+  }
+  failed = true;
+}
+
+// Read the lookahead past if it is t; otherwise it is an error.
+static bool expect(int t)
+{
+  if (peek() != t) {
+    syntax_error();
+    return false;
+  }
+  shift();
+  return true;
+}
+
+static Symbol expect_symbol(int t)
+{
+  peek();
+  Symbol sym = token_value.symbol;
+  return expect(t) ? sym : NULL;
+}
+
+//
+// Recover from an error, in a state that shifts error and then one of
+// sync1 and sync2: discard tokens up to one of them, which is left as
+// the lookahead.  Returns false if the parse has been given up.
+//
+static bool recover(int sync1, int sync2)
+{
+  if (aborted)
+    return false;
+  failed = false;
+  errstatus = 3;
+  while (peek() != sync1 && peek() != sync2) {
+    if (token == 0) {
+      failed = aborted = true;
+      return false;
+    }
+    token = NO_TOKEN;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Expressions
+//
+//////////////////////////////////////////////////////////////////////
+
+//
+// The levels of cool.y's precedence declarations, lowest first.
+//
+enum { PREC_NONE, PREC_ASSIGN, PREC_NOT, PREC_COMPARE, PREC_ADD, PREC_MUL,
+       PREC_ISVOID, PREC_NEG, PREC_AT, PREC_DOT };
+
+// The level of a token that continues an expression, or PREC_NONE.
+static int precedence(int t)
+{
+  switch (t) {
+  case LE: case '<': case '=':  return PREC_COMPARE;
+  case '+': case '-':           return PREC_ADD;
+  case '*': case '/':           return PREC_MUL;
+  case '@':                     return PREC_AT;
+  case '.':                     return PREC_DOT;
+  default:                      return PREC_NONE;
+  }
+}
+
+static Expression parse_expr(int min, int *line);
+static Expression parse_let_expr();
+
+//
+// param_expr: [expr] {',' expr}, up to the closing ')', which is read.
+//
+static Expressions parse_params()
+{
+  Expressions params = NULL;
+  int line;
+  switch (peek()) {
+  case ',':
+  case ')':
+    params = nil_Expressions();
+    break;
+  default: {
+    Expression e = parse_expr(PREC_NONE, &line);
+    if (failed)
+      return NULL;
+    node_lineno = line;
+    params = single_Expressions(e);
+  }
+  }
+  while (peek() == ',') {
+    shift();
+    Expression e = parse_expr(PREC_NONE, &line);
+    if (failed)
+      return NULL;
+    params = extend(params, e);
+  }
+  expect(')');
+  return params;
+}
+
+//
+// '{' one_or_more_expr '}', a point of recovery: one_or_more_expr can be
+// error ';'.
+//
+static Expression parse_block()
+{
+  int line = shift();
+  Expressions body = NULL;
+  do {
+    int el;
+    Expression e = parse_expr(PREC_NONE, &el);
+    if (!failed && expect(';')) {
+      node_lineno = el;
+      body = body ? extend(body, e) : single_Expressions(e);
+    } else {
+      if (!recover(';', ';'))
+        return NULL;
+      shift();
+      body = NULL;
+    }
+  } while (peek() != '}');
+  shift();
+  node_lineno = line;
+  return block(body);
+}
+
+//
+// CASE expr OF case_branch_list ESAC
+//
+static Expression parse_case()
+{
+  int line = shift();
+  int el;
+  Expression e = parse_expr(PREC_NONE, &el);
+  if (failed || !expect(OF))
+    return NULL;
+  Cases cases = NULL;
+  do {
+    Symbol name = expect_symbol(OBJECTID);
+    int bl = token_line;
+    if (failed || !expect(':'))
+      return NULL;
+    Symbol type = expect_symbol(TYPEID);
+    if (failed || !expect(DARROW))
+      return NULL;
+    Expression body = parse_expr(PREC_NONE, &el);
+    if (failed || !expect(';'))
+      return NULL;
+    node_lineno = bl;
+    Case c = branch(name, type, body);
+    cases = cases ? extend(cases, c) : single_Cases(c);
+  } while (peek() != ESAC);
+  shift();
+  node_lineno = line;
+  return typcase(e, cases);
+}
+
+//
+// An expression that is not an operand of a binary operator.  Sets *line
+// to its location.
+//
+static Expression parse_operand(int *line)
+{
+  int t = peek();
+  *line = token_line;
+  Expression e, e2, e3;
+  int el;
+
+  switch (t) {
+  case OBJECTID: {
+    Symbol name = token_value.symbol;
+    shift();
+    if (peek() == ASSIGN) {
+      shift();
+      e = parse_expr(PREC_ASSIGN, &el);
+      if (failed)
+        return NULL;
+      node_lineno = *line;
+      return assign(name, e);
+    }
+    if (peek() == '(') {
+      shift();
+      Expressions params = parse_params();
+      if (failed)
+        return NULL;
+      node_lineno = *line;
+      return dispatch(object(idtable.add_string("self")), name, params);
+    }
+    node_lineno = *line;
+    return object(name);
+  }
+  case INT_CONST:
+  case STR_CONST: {
+    Symbol sym = token_value.symbol;
+    shift();
+    node_lineno = *line;
+    return t == INT_CONST ? int_const(sym) : string_const(sym);
+  }
+  case BOOL_CONST: {
+    Boolean b = token_value.boolean;
+    shift();
+    node_lineno = *line;
+    return bool_const(b);
+  }
+  case '(':
+    shift();
+    e = parse_expr(PREC_NONE, &el);
+    if (failed || !expect(')'))
+      return NULL;
+    return e;
+  case '{':
+    return parse_block();
+  case IF:
+    shift();
+    e = parse_expr(PREC_NONE, &el);
+    if (failed || !expect(THEN))
+      return NULL;
+    e2 = parse_expr(PREC_NONE, &el);
+    if (failed || !expect(ELSE))
+      return NULL;
+    e3 = parse_expr(PREC_NONE, &el);
+    if (failed || !expect(FI))
+      return NULL;
+    node_lineno = *line;
+    return cond(e, e2, e3);
+  case WHILE:
+    shift();
+    e = parse_expr(PREC_NONE, &el);
+    if (failed || !expect(LOOP))
+      return NULL;
+    e2 = parse_expr(PREC_NONE, &el);
+    if (failed || !expect(POOL))
+      return NULL;
+    node_lineno = *line;
+    return loop(e, e2);
+  case LET:
+    shift();
+    return parse_let_expr();
+  case CASE:
+    return parse_case();
+  case NEW: {
+    shift();
+    Symbol type = expect_symbol(TYPEID);
+    if (failed)
+      return NULL;
+    node_lineno = *line;
+    return new_(type);
+  }
+  case ISVOID:
+  case '~':
+  case NOT:
+    shift();
+    e = parse_expr(t == ISVOID ? PREC_ISVOID : t == '~' ? PREC_NEG : PREC_NOT,
+                   &el);
+    if (failed)
+      return NULL;
+    node_lineno = *line;
+    return t == ISVOID ? isvoid(e) : t == '~' ? neg(e) : comp(e);
+  default:
+    syntax_error();
+    return NULL;
+  }
+}
+
+//
+// An expression whose operators bind tighter than level min.  Sets *line
+// to its location, which is also that of the nodes of its operators.
+//
+static Expression parse_expr(int min, int *line)
+{
+  Expression e = parse_operand(line);
+  int last = PREC_NONE;         // the level of the last operator
+  int el;
+
+  while (!failed) {
+    int op = peek();
+    int prec = precedence(op);
+    if (prec <= min)
+      break;
+    if (prec == PREC_COMPARE && last == PREC_COMPARE) {
+      syntax_error();           // the comparisons are %nonassoc
+      break;
+    }
+    last = prec;
+    shift();
+
+    if (op == '.' || op == '@') {
+      Symbol type = NULL;
+      if (op == '@') {
+        type = expect_symbol(TYPEID);
+        if (failed || !expect('.'))
+          break;
+      }
+      Symbol name = expect_symbol(OBJECTID);
+      if (failed || !expect('('))
+        break;
+      Expressions params = parse_params();
+      if (failed)
+        break;
+      node_lineno = *line;
+      e = op == '.' ? dispatch(e, name, params)
+                    : static_dispatch(e, type, name, params);
+      continue;
+    }
+
+    Expression e2 = parse_expr(prec, &el);
+    if (failed)
+      break;
+    node_lineno = *line;
+    switch (op) {
+    case '+': e = plus(e, e2); break;
+    case '-': e = sub(e, e2); break;
+    case '*': e = mul(e, e2); break;
+    case '/': e = divide(e, e2); break;
+    case '<': e = lt(e, e2); break;
+    case '=': e = eq(e, e2); break;
+    case LE:  e = leq(e, e2); break;
+    }
+  }
+  return failed ? NULL : e;
+}
+
+//
+// let_expr, after LET or after the ',' of another: a point of recovery,
+// as let_expr can be error IN expr or error ',' let_expr.
+//
+static Expression parse_let_expr()
+{
+  int el;
+
+  if (peek() == OBJECTID) {
+    int line = token_line;
+    Symbol name = token_value.symbol;
+    shift();
+    Symbol type = NULL;
+    Expression init = NULL, body = NULL;
+    if (expect(':'))
+      type = expect_symbol(TYPEID);
+    if (!failed && peek() == ASSIGN) {
+      shift();
+      init = parse_expr(PREC_NONE, &el);
+    }
+    if (!failed) {
+      if (peek() == IN) {
+        shift();
+        body = parse_expr(PREC_NONE, &el);
+      } else if (peek() == ',') {
+        shift();
+        body = parse_let_expr();
+      } else
+        syntax_error();
+    }
+    if (!failed) {
+      node_lineno = line;
+      return let(name, type, init ? init : no_expr(), body);
+    }
+  } else
+    syntax_error();
+
+  // An error in what follows error IN is recovered from here again.
+  do {
+    if (!recover(IN, ','))
+      return NULL;
+    if (peek() == IN) {
+      shift();
+      parse_expr(PREC_NONE, &el);
+    } else {
+      shift();
+      parse_let_expr();
+    }
+  } while (failed);
+  token = NO_TOKEN;             // the rules' yyclearin
+  return NULL;
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Declarations
+//
+//////////////////////////////////////////////////////////////////////
+
+//
+// formals: [formal] {',' formal}, up to the closing ')', which is read.
+//
+static Formals parse_formals()
+{
+  Formals formals = NULL;
+  if (peek() != OBJECTID)
+    formals = nil_Formals();
+  for (;;) {
+    if (formals != NULL) {
+      if (peek() != ',')
+        break;
+      shift();
+    }
+    Symbol name = expect_symbol(OBJECTID);
+    int line = token_line;
+    if (failed || !expect(':'))
+      return NULL;
+    Symbol type = expect_symbol(TYPEID);
+    if (failed)
+      return NULL;
+    node_lineno = line;
+    Formal f = formal(name, type);
+    formals = formals ? extend(formals, f) : single_Formals(f);
+  }
+  expect(')');
+  return formals;
+}
+
+static Feature parse_feature()
+{
+  int line = token_line;
+  Symbol name = token_value.symbol;
+  shift();
+  int el;
+
+  if (peek() == '(') {
+    shift();
+    Formals formals = parse_formals();
+    if (failed || !expect(':'))
+      return NULL;
+    Symbol type = expect_symbol(TYPEID);
+    if (failed || !expect('{'))
+      return NULL;
+    Expression body = parse_expr(PREC_NONE, &el);
+    if (failed || !expect('}'))
+      return NULL;
+    node_lineno = line;
+    return method(name, formals, type, body);
+  }
+  if (!expect(':'))
+    return NULL;
+  Symbol type = expect_symbol(TYPEID);
+  if (failed)
+    return NULL;
+  if (peek() != ASSIGN) {
+    node_lineno = line;
+    return attr(name, type, no_expr());
+  }
+  shift();
+  Expression init = parse_expr(PREC_NONE, &el);
+  if (failed)
+    return NULL;
+  node_lineno = line;
+  return attr(name, type, init);
+}
+
+//
+// The features of a class and the '}' ';' that end it, after its '{': a
+// point of recovery, as features can be error ';', and the class can be
+// error '}' ';' after the '{' unless it inherits (then sync is ';').
+// Clears *ok if it is.
+//
+static Features parse_class_body(int sync, bool *ok)
+{
+  Features features = NULL;
+  for (;;) {
+    while (!failed && peek() == OBJECTID) {
+      int line = token_line;
+      Feature f = parse_feature();
+      if (failed || !expect(';'))
+        break;
+      node_lineno = line;
+      features = features ? extend(features, f) : single_Features(f);
+    }
+    if (!failed && expect('}') && expect(';'))
+      return features ? features : nil_Features();
+
+    if (!recover(';', sync))
+      return NULL;
+    if (peek() == ';') {
+      shift();                  // features: error ';'
+      features = NULL;
+    } else {
+      shift();                  // class: ... '{' error '}' ';'
+      *ok = false;
+      if (expect(';'))
+        return NULL;
+    }
+  }
+}
+
+//
+// A class, at its CLASS: a point of recovery, as the class can be CLASS
+// error '{' ... .  Returns NULL if it is one of the error rules.
+//
+static Class_ parse_class()
+{
+  int line = shift();
+  Symbol name = NULL, parent = NULL;
+  int sync = '}';
+  bool ok = true;
+
+  name = expect_symbol(TYPEID);
+  if (!failed && peek() == INHERITS) {
+    shift();
+    parent = expect_symbol(TYPEID);
+    sync = ';';
+  }
+  if (!failed)
+    expect('{');
+  if (failed) {
+    if (!recover('{', '{'))
+      return NULL;
+    shift();
+    sync = '}';
+    ok = false;
+  }
+
+  Features features = parse_class_body(sync, &ok);
+  if (failed || !ok)
+    return NULL;
+  node_lineno = line;
+  return class_(name, parent ? parent : idtable.add_string("Object"),
+                features, stringtable.add_string(curr_filename));
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  The parse
+//
+//////////////////////////////////////////////////////////////////////
+
+//
+// Parse the tokens of cool_yylex.  Sets ast_root, and returns 0 if the
+// parse succeeded, as cool_yyparse.
+//
+int cool_rd_parse()
+{
+  token = NO_TOKEN;
+  errstatus = 0;
+  failed = aborted = false;
+
+  Classes classes = NULL;
+  int line = 0;
+  if (peek() != CLASS)
+    syntax_error();
+  while (!failed) {
+    int cl = token_line;
+    Class_ c = parse_class();
+    if (failed)
+      break;
+    if (classes == NULL) {
+      line = cl;
+      node_lineno = line;
+      classes = single_Classes(c);
+    } else {
+      node_lineno = line;
+      classes = extend(classes, c);
+    }
+    parse_results = classes;
+    if (peek() == 0)
+      break;
+    if (peek() != CLASS)
+      syntax_error();
+  }
+  if (failed)
+    return 1;
+  node_lineno = line;
+  ast_root = program(classes);
+  return 0;
+}
+
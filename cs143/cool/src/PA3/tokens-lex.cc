@@ -699,9 +699,15 @@ char *yytext;
 #include "stringtab.h"
 #include "utilities.h"
 
-/* The compiler assumes these identifiers. */
-#define yylval cool_yylval
-#define yylex  cool_yylex
+/* The scanner leaves each token's value, line and file in variables of
+ * its own, which cool_text_yylex in parser-phase.cc copies to the
+ * parser's cool_yylval, curr_lineno and curr_filename.  The push parser
+ * runs the scanner on a thread of its own (see parser-push.cc). */
+#define yylval        tokens_lval
+#define curr_lineno   tokens_lineno
+#define curr_filename tokens_filename
+#define yylex         tokens_yylex
+extern YYSTYPE tokens_lval;
 
 /* Max size of string constants */
 #define MAX_STR_CONST 1025
@@ -25,6 +25,11 @@
 extern int yy_flex_debug;       // for the lexer; prints recognized rules
 extern int cool_yydebug;        // for the parser
        int lex_verbose;         // also for the lexer; prints tokens
+       int lex_mmap;            // lexer scans input files in memory
+       int lex_jobs;            // lexer threads for several input files
+       int token_binary;        // lexer writes, parser reads binary tokens
+       int parse_split;         // parser splits files at their classes
+       char *token_cache_dir;   // lexer caches tokens in this directory
        int semant_debug;        // for semantic analysis
        int cgen_debug;          // for code gen
        bool disable_reg_alloc;  // Don't do register allocation
@@ -47,13 +52,18 @@ void handle_flags(int argc, char *argv[]) {
   yy_flex_debug = 0;
   cool_yydebug = 0;
   lex_verbose  = 0;
+  lex_mmap     = 0;
+  lex_jobs     = 0;
+  token_binary = 0;
+  parse_split  = 0;
+  token_cache_dir = NULL;
   semant_debug = 0;
   cgen_debug = 0;
   cgen_optimize = 0;
   disable_reg_alloc = 0;
   
 
-  while ((c = getopt(argc, argv, "lpscvrOo:gtT")) != -1) {
+  while ((c = getopt(argc, argv, "lpscvrOo:gtTmj:bSC:")) != -1) {
     switch (c) {
 #ifdef DEBUG
     case 'l':
@@ -99,6 +109,21 @@ void handle_flags(int argc, char *argv[]) {
     case 'O':  // enable optimization
       cgen_optimize = 1;
       break;
+    case 'm':  // map each input file into memory instead of reading it
+      lex_mmap = 1;
+      break;
+    case 'j':  // lex the input files on this many threads
+      lex_jobs = atoi(optarg);
+      break;
+    case 'b':  // pass tokens from lexer to parser in binary
+      token_binary = 1;
+      break;
+    case 'S':  // parse the classes of each file on several threads
+      parse_split = 1;
+      break;
+    case 'C':  // cache the tokens of input files in this directory
+      token_cache_dir = optarg;
+      break;
     case '?':
       unknownopt = 1;
       break;
@@ -111,9 +136,9 @@ void handle_flags(int argc, char *argv[]) {
   if (unknownopt) {
       cerr << "usage: " << argv[0] << 
 #ifdef DEBUG
-	  " [-lvpscOgtTr -o outname] [input-files]\n";
+	  " [-lvpscOgtTrmbS -j jobs -C cachedir -o outname] [input-files]\n";
 #else
-      " [-OgtT -o outname] [input-files]\n";
+      " [-OgtTmbS -j jobs -C cachedir -o outname] [input-files]\n";
 #endif
       exit(1);
   }
@@ -16,5 +16,6 @@ int main(int argc, char *argv[]) {
   ast_yyparse();
   ast_root->semant();
   ast_root->dump_with_types(cout,0);
+  release_nodes();
 }
 
@@ -5,6 +5,7 @@
 #include "copyright.h"
 
 #include <assert.h>
+#include <stdlib.h>
 #include "stringtab_functions.h"
 #include "stringtab.h"
 
@@ -18,10 +19,26 @@ template class StringTable<IdEntry>;
 template class StringTable<StringEntry>;
 template class StringTable<IntEntry>;
 
-Entry::Entry(char *s, int l, int i) : len(l), index(i) {
-  str = new char [len+1];
-  strncpy(str, s, len);
+Entry::Entry(char *s, int l, int i, Arena *a) : len(l), index(i) {
+  str = a ? (char *) a->alloc(len+1) : new char [len+1];
+  memcpy(str, s, len);
   str[len] = '\0';
+  hashval = hash_string(str, len);
+}
+
+//
+// hash_string is the 32-bit FNV-1a hash.  It is cheap to compute for the
+// short identifiers and constants that make up most of the string tables,
+// and it spreads them well over the low bits used to index hash_tbl.
+//
+unsigned int Entry::hash_string(char *s, int len)
+{
+  unsigned int h = 2166136261u;
+  for (int i = 0; i < len; i++) {
+    h ^= (unsigned char) s[i];
+    h *= 16777619u;
+  }
+  return h;
 }
 
 int Entry::equal_string(char *string, int length) const
@@ -70,9 +87,71 @@ void dump_Symbol(ostream& s, int n, Symbol sym)
   s << pad(n) << sym << endl;
 }
 
-StringEntry::StringEntry(char *s, int l, int i) : Entry(s,l,i) { }
-IdEntry::IdEntry(char *s, int l, int i) : Entry(s,l,i) { }
-IntEntry::IntEntry(char *s, int l, int i) : Entry(s,l,i) { }
+StringEntry::StringEntry(char *s, int l, int i, Arena *a) : Entry(s,l,i,a) { }
+IdEntry::IdEntry(char *s, int l, int i, Arena *a) : Entry(s,l,i,a) { }
+IntEntry::IntEntry(char *s, int l, int i, Arena *a) : Entry(s,l,i,a)
+{
+  value = (int) strtol(str, NULL, 10);
+}
+
+//
+// The slot of int_tbl at which the search for an integer starts.
+//
+static unsigned int int_hash(int i, int size)
+{
+  unsigned int h = (unsigned int) i * 2654435761u;
+  return (h ^ (h >> 16)) & (size - 1);
+}
+
+void IntTable::int_grow()
+{
+  IntEntry **old_tbl = int_tbl;
+  int old_size = int_size;
+
+  int_size = old_size ? 2 * old_size : 64;
+  int_tbl = new IntEntry *[int_size];
+  memset(int_tbl, 0, int_size * sizeof(IntEntry *));
+
+  for (int j = 0; j < old_size; j++)
+    if (old_tbl[j]) {
+      unsigned int k = int_hash(old_tbl[j]->get_value(), int_size);
+      while (int_tbl[k])
+        k = (k + 1) & (int_size - 1);
+      int_tbl[k] = old_tbl[j];
+    }
+  delete [] old_tbl;
+}
+
+//
+// add_int first looks the integer up by value.  Only if it is not there
+// is its string representation formatted and added to the table.
+//
+IntEntry *IntTable::add_int(int i)
+{
+  if (2 * (int_count + 1) > int_size)
+    int_grow();
+
+  unsigned int k = int_hash(i, int_size);
+  for (; int_tbl[k]; k = (k + 1) & (int_size - 1))
+    if (int_tbl[k]->get_value() == i)
+      return int_tbl[k];
+
+  char buf[20];
+  snprintf(buf, sizeof(buf), "%d", i);
+  IntEntry *e = add_string(buf);
+  int_tbl[k] = e;
+  int_count++;
+  return e;
+}
+
+void IntTable::clear()
+{
+  StringTable<IntEntry>::clear();
+  delete [] int_tbl;
+  int_tbl = (IntEntry **) NULL;
+  int_size = 0;
+  int_count = 0;
+}
 
 IdTable idtable;
 IntTable inttable;
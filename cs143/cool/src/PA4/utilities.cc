@@ -124,39 +124,45 @@ char *cool_token_to_string(int tok)
 }
 
 void print_cool_token(int tok)
+{
+  print_cool_token(cerr, tok, cool_yylval);
+}
+
+// print the token tok, whose semantic value is yylval, on out
+void print_cool_token(ostream& out, int tok, YYSTYPE& yylval)
 {
 
-  cerr << cool_token_to_string(tok);
+  out << cool_token_to_string(tok);
 
   switch (tok) {
   case (STR_CONST):
-    cerr << " = ";
-    cerr << " \"";
-    print_escaped_string(cerr, cool_yylval.symbol->get_string());
-    cerr << "\"";
+    out << " = ";
+    out << " \"";
+    print_escaped_string(out, yylval.symbol->get_string());
+    out << "\"";
 #ifdef CHECK_TABLES
-    stringtable.lookup_string(cool_yylval.symbol->get_string());
+    stringtable.lookup_string(yylval.symbol->get_string());
 #endif
     break;
   case (INT_CONST):
-    cerr << " = " << cool_yylval.symbol;
+    out << " = " << yylval.symbol;
 #ifdef CHECK_TABLES
-    inttable.lookup_string(cool_yylval.symbol->get_string());
+    inttable.lookup_string(yylval.symbol->get_string());
 #endif
     break;
   case (BOOL_CONST):
-    cerr << (cool_yylval.boolean ? " = true" : " = false");
+    out << (yylval.boolean ? " = true" : " = false");
     break;
   case (TYPEID):
   case (OBJECTID):
-    cerr << " = " << cool_yylval.symbol;
+    out << " = " << yylval.symbol;
 #ifdef CHECK_TABLES
-    idtable.lookup_string(cool_yylval.symbol->get_string());
+    idtable.lookup_string(yylval.symbol->get_string());
 #endif
     break;
   case (ERROR): 
-    cerr << " = ";
-    print_escaped_string(cerr, cool_yylval.error_msg);
+    out << " = ";
+    print_escaped_string(out, yylval.error_msg);
     break;
   }
 }
@@ -169,26 +175,26 @@ void dump_cool_token(ostream& out, int lineno, int token, YYSTYPE yylval)
     switch (token) {
     case (STR_CONST):
 	out << " \"";
-	print_escaped_string(out, cool_yylval.symbol->get_string());
+	print_escaped_string(out, yylval.symbol->get_string());
 	out << "\"";
 #ifdef CHECK_TABLES
-	stringtable.lookup_string(cool_yylval.symbol->get_string());
+	stringtable.lookup_string(yylval.symbol->get_string());
 #endif
 	break;
     case (INT_CONST):
-	out << " " << cool_yylval.symbol;
+	out << " " << yylval.symbol;
 #ifdef CHECK_TABLES
-	inttable.lookup_string(cool_yylval.symbol->get_string());
+	inttable.lookup_string(yylval.symbol->get_string());
 #endif
 	break;
     case (BOOL_CONST):
-	out << (cool_yylval.boolean ? " true" : " false");
+	out << (yylval.boolean ? " true" : " false");
 	break;
     case (TYPEID):
     case (OBJECTID):
-	out << " " << cool_yylval.symbol;
+	out << " " << yylval.symbol;
 #ifdef CHECK_TABLES
-	idtable.lookup_string(cool_yylval.symbol->get_string());
+	idtable.lookup_string(yylval.symbol->get_string());
 #endif
 	break;
     case (ERROR): 
@@ -197,17 +203,17 @@ void dump_cool_token(ostream& out, int lineno, int token, YYSTYPE yylval)
         // if we see an "empty" string here, we can safely assume the
         // lexer is reporting an occurrance of an illegal NUL in the
         // input stream
-        if (cool_yylval.error_msg[0] == 0) {
+        if (yylval.error_msg[0] == 0) {
           out << " \"\\000\"";
         }
         else {
           out << " \"";
-          print_escaped_string(out, cool_yylval.error_msg);
+          print_escaped_string(out, yylval.error_msg);
           out << "\"";
           break;
         }
     }
-    out << endl;
+    out << '\n';
 }
 
 //
@@ -47,5 +47,6 @@ int main(int argc, char *argv[]) {
   } else {
       ast_root->cgen(cout);
   }
+  release_nodes();
 }
 
@@ -127,19 +127,19 @@ void dump_line(ostream& stream, int n, tree_node *t)
 //  program_class prints "program" and then each of the
 //  component classes of the program, one at a time, at a
 //  greater indentation. The recursive invocation on
-//  "classes->nth(i)->dump_with_types(...)" shows how useful
+//  "(*i)->dump_with_types(...)" shows how useful
 //  and compact virtual functions are for this kind of computation.
 //
 //  Note the use of the iterator to cycle through all of the
-//  classes.  The methods first, more, next, and nth on AST lists
-//  are defined in tree.h.
+//  classes.  The iterator, and the methods first, more, next, and nth
+//  on AST lists, are defined in tree.h.
 //
 void program_class::dump_with_types(ostream& stream, int n)
 {
    dump_line(stream,n,this);
    stream << pad(n) << "_program\n";
-   for(int i = classes->first(); classes->more(i); i = classes->next(i))
-     classes->nth(i)->dump_with_types(stream, n+2);
+   for(Classes_class::iterator i = classes->begin(); i != classes->end(); ++i)
+     (*i)->dump_with_types(stream, n+2);
 }
 
 //
@@ -155,8 +155,8 @@ void class__class::dump_with_types(ostream& stream, int n)
    stream << pad(n+2) << "\"";
    print_escaped_string(stream, filename->get_string());
    stream << "\"\n" << pad(n+2) << "(\n";
-   for(int i = features->first(); features->more(i); i = features->next(i))
-     features->nth(i)->dump_with_types(stream, n+2);
+   for(Features_class::iterator i = features->begin(); i != features->end(); ++i)
+     (*i)->dump_with_types(stream, n+2);
    stream << pad(n+2) << ")\n";
 }
 
@@ -173,8 +173,8 @@ void method_class::dump_with_types(ostream& stream, int n)
    dump_line(stream,n,this);
    stream << pad(n) << "_method\n";
    dump_Symbol(stream, n+2, name);
-   for(int i = formals->first(); formals->more(i); i = formals->next(i))
-     formals->nth(i)->dump_with_types(stream, n+2);
+   for(Formals_class::iterator i = formals->begin(); i != formals->end(); ++i)
+     (*i)->dump_with_types(stream, n+2);
    dump_Symbol(stream, n+2, return_type);
    expr->dump_with_types(stream, n+2);
 }
@@ -245,8 +245,8 @@ void static_dispatch_class::dump_with_types(ostream& stream, int n)
    dump_Symbol(stream, n+2, type_name);
    dump_Symbol(stream, n+2, name);
    stream << pad(n+2) << "(\n";
-   for(int i = actual->first(); actual->more(i); i = actual->next(i))
-     actual->nth(i)->dump_with_types(stream, n+2);
+   for(Expressions_class::iterator i = actual->begin(); i != actual->end(); ++i)
+     (*i)->dump_with_types(stream, n+2);
    stream << pad(n+2) << ")\n";
    dump_type(stream,n);
 }
@@ -262,8 +262,8 @@ void dispatch_class::dump_with_types(ostream& stream, int n)
    expr->dump_with_types(stream, n+2);
    dump_Symbol(stream, n+2, name);
    stream << pad(n+2) << "(\n";
-   for(int i = actual->first(); actual->more(i); i = actual->next(i))
-     actual->nth(i)->dump_with_types(stream, n+2);
+   for(Expressions_class::iterator i = actual->begin(); i != actual->end(); ++i)
+     (*i)->dump_with_types(stream, n+2);
    stream << pad(n+2) << ")\n";
    dump_type(stream,n);
 }
@@ -305,8 +305,8 @@ void typcase_class::dump_with_types(ostream& stream, int n)
    dump_line(stream,n,this);
    stream << pad(n) << "_typcase\n";
    expr->dump_with_types(stream, n+2);
-   for(int i = cases->first(); cases->more(i); i = cases->next(i))
-     cases->nth(i)->dump_with_types(stream, n+2);
+   for(Cases_class::iterator i = cases->begin(); i != cases->end(); ++i)
+     (*i)->dump_with_types(stream, n+2);
    dump_type(stream,n);
 }
 
@@ -319,8 +319,8 @@ void block_class::dump_with_types(ostream& stream, int n)
 {
    dump_line(stream,n,this);
    stream << pad(n) << "_block\n";
-   for(int i = body->first(); body->more(i); i = body->next(i))
-     body->nth(i)->dump_with_types(stream, n+2);
+   for(Expressions_class::iterator i = body->begin(); i != body->end(); ++i)
+     (*i)->dump_with_types(stream, n+2);
    dump_type(stream,n);
 }
 
@@ -18,6 +18,39 @@
 /* line number to assign to the current node being constructed */
 int node_lineno = 1;
 
+/* where this thread's nodes take their line number from */
+thread_local int *node_line = &node_lineno;
+
+/* the arena of the compilation, and the one nodes are allocated from */
+static Arena compilation_arena;
+thread_local Arena *node_arena = &compilation_arena;
+
+///////////////////////////////////////////////////////////////////////////
+//
+// set_node_arena
+//
+// allocate new nodes from a; returns the arena they were allocated from
+//
+///////////////////////////////////////////////////////////////////////////
+Arena *set_node_arena(Arena *a)
+{
+    Arena *old = node_arena;
+    node_arena = a;
+    return old;
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// release_nodes
+//
+// free the nodes of the compilation arena
+//
+///////////////////////////////////////////////////////////////////////////
+void release_nodes()
+{
+    compilation_arena.release();
+}
+
 ///////////////////////////////////////////////////////////////////////////
 //
 // tree_node::tree_node
@@ -27,7 +60,7 @@ int node_lineno = 1;
 ///////////////////////////////////////////////////////////////////////////
 tree_node::tree_node()
 {
-    line_number = node_lineno;
+    line_number = *node_line;
 }
 
 ///////////////////////////////////////////////////////////////////////////